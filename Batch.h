@@ -0,0 +1,233 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ConfigSetup.h"
+#include "Parallel.h"
+
+/**
+ * One line of a sweep: the settings it changes and the values to try. Grouped
+ * settings (e.g. WORLD_LEN,WORLD_WIDTH) change together.
+ */
+struct SweepAxis
+{
+  std::vector<std::string> names;
+  std::vector<std::vector<std::string>> values;
+};
+
+/**
+ * A parameter sweep read from a text file. Every line names one setting, or
+ * several separated by commas, followed by the values to try. Grouped settings
+ * take comma separated values that change together. '#' starts a comment.
+ *
+ *   SEED 1 2 3 4 5
+ *   MUTATION_RATE 0.001 0.0075
+ *   WORLD_LEN,WORLD_WIDTH 30,30 60,60
+ *
+ * The runs cover every combination of the lines, here 5 x 2 x 2 = 20 runs.
+ */
+class SweepSpec
+{
+  std::vector<SweepAxis> axes;
+  std::string error;
+
+  static std::vector<std::string> Split(const std::string &str, char sep)
+  {
+    std::vector<std::string> parts;
+    std::stringstream ss(str);
+    std::string part;
+    while (std::getline(ss, part, sep))
+      parts.push_back(part);
+    return parts;
+  }
+
+public:
+  /**
+   * Input: The sweep file and the config whose settings it may change
+   *
+   * Output: Whether the file could be read; GetError says why not
+   *
+   * Purpose: Parse a sweep file.
+   */
+  bool Load(const std::string &filename, MyConfigType &config)
+  {
+    std::ifstream in(filename);
+    if (!in)
+    {
+      error = "Could not open sweep file " + filename;
+      return false;
+    }
+
+    std::string line;
+    for (size_t line_num = 1; std::getline(in, line); ++line_num)
+    {
+      line = line.substr(0, line.find('#'));
+      std::stringstream ss(line);
+      std::string names;
+      if (!(ss >> names))
+        continue;
+
+      SweepAxis axis;
+      axis.names = Split(names, ',');
+      for (const std::string &name : axis.names)
+      {
+        if (!config.Has(name))
+        {
+          error = filename + ":" + std::to_string(line_num) + ": unknown setting " + name;
+          return false;
+        }
+      }
+      std::string value;
+      while (ss >> value)
+      {
+        axis.values.push_back(Split(value, ','));
+        if (axis.values.back().size() != axis.names.size())
+        {
+          error = filename + ":" + std::to_string(line_num) + ": expected " +
+                  std::to_string(axis.names.size()) + " values in " + value;
+          return false;
+        }
+      }
+      if (axis.values.empty())
+      {
+        error = filename + ":" + std::to_string(line_num) + ": no values for " + names;
+        return false;
+      }
+      axes.push_back(axis);
+    }
+    return true;
+  }
+
+  const std::string &GetError() const { return error; }
+  const std::vector<SweepAxis> &GetAxes() const { return axes; }
+
+  size_t GetNumRuns() const
+  {
+    size_t runs = 1;
+    for (const SweepAxis &axis : axes)
+      runs *= axis.values.size();
+    return runs;
+  }
+
+  /**
+   * Input: A run number below GetNumRuns()
+   *
+   * Output: The (setting, value) pairs of that run
+   *
+   * Purpose: Runs count through the combinations with the last line changing fastest.
+   */
+  std::vector<std::pair<std::string, std::string>> GetRunSettings(size_t run) const
+  {
+    std::vector<std::pair<std::string, std::string>> settings;
+    for (size_t a = axes.size(); a-- > 0;)
+    {
+      const SweepAxis &axis = axes[a];
+      const std::vector<std::string> &values = axis.values[run % axis.values.size()];
+      run /= axis.values.size();
+      for (size_t i = 0; i < axis.names.size(); ++i)
+        settings.emplace_back(axis.names[i], values[i]);
+    }
+    std::reverse(settings.begin(), settings.end());
+    return settings;
+  }
+};
+
+/**
+ * Runs every point of a sweep as an independent experiment on a pool of
+ * threads. Each run gets its own copy of the config, with the sweep's settings
+ * applied, and an output prefix ("run_0007_") for all of its files. Runs with
+ * THREAD_NUM > 0 start their own workers on top of the batch threads.
+ */
+class BatchRunner
+{
+public:
+  using run_fun_t = std::function<int(const MyConfigType &, const std::string &)>;
+
+  /**
+   * Input: The base config, the sweep, the number of runs to do at once (0 for
+   * one per hardware thread), the function that performs one run, and a log stream
+   *
+   * Output: 0 if every run succeeded, 1 otherwise
+   *
+   * Purpose: Run the whole sweep. batch_runs.csv lists the settings of every run.
+   */
+  static int Run(MyConfigType &base, const SweepSpec &spec, size_t num_threads, run_fun_t run_fun, std::ostream &log)
+  {
+    const size_t num_runs = spec.GetNumRuns();
+    std::stringstream base_settings;
+    base.Write(base_settings);
+
+    // Configs are built up front, emp's config parsing isn't meant to run concurrently
+    std::vector<std::unique_ptr<MyConfigType>> configs;
+    std::vector<std::string> prefixes;
+    std::ofstream index("batch_runs.csv");
+    index << "run,prefix";
+    for (const SweepAxis &axis : spec.GetAxes())
+    {
+      for (const std::string &name : axis.names)
+        index << "," << name;
+    }
+    index << "\n";
+
+    for (size_t run = 0; run < num_runs; ++run)
+    {
+      char prefix[32];
+      std::snprintf(prefix, sizeof(prefix), "run_%04zu_", run);
+      prefixes.push_back(prefix);
+
+      configs.push_back(std::make_unique<MyConfigType>());
+      MyConfigType &config = *configs.back();
+      std::stringstream settings(base_settings.str());
+      config.Read(settings);
+      config.BATCH_FILE("");
+
+      index << run << "," << prefix;
+      for (const auto &[name, value] : spec.GetRunSettings(run))
+      {
+        config.Set(name, value);
+        index << "," << value;
+      }
+      index << "\n";
+
+      config.CHECKPOINT_FILE(prefix + config.CHECKPOINT_FILE());
+      if (!config.TRACE_FILE().empty())
+        config.TRACE_FILE(prefix + config.TRACE_FILE());
+      if (!config.PROFILE_FILE().empty())
+        config.PROFILE_FILE(prefix + config.PROFILE_FILE());
+    }
+    index.close();
+
+    if (num_threads == 0)
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    WorkerPool pool(std::min(num_threads, num_runs));
+
+    std::mutex log_mutex;
+    std::vector<int> status(num_runs, 0);
+    size_t finished = 0;
+    pool.Run(num_runs, [&](size_t run)
+             {
+      status[run] = run_fun(*configs[run], prefixes[run]);
+      std::lock_guard<std::mutex> lock(log_mutex);
+      log << "Run " << run << " (" << ++finished << "/" << num_runs << ") "
+          << (status[run] == 0 ? "finished" : "failed") << std::endl; });
+
+    for (int code : status)
+    {
+      if (code != 0)
+        return 1;
+    }
+    return 0;
+  }
+};
+
+#endif
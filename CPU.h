@@ -67,6 +67,37 @@ public:
     InitializeState();
   }
 
+  /**
+   * Input: The parent's CPU and the mutation rate
+   *
+   * Output: None
+   *
+   * Purpose: Turn this CPU into a freshly mutated copy of the parent, the same
+   * as copying the parent, calling Reset() and then Mutate(). The program and
+   * the retrieved values keep their storage, so nothing is allocated.
+   */
+  void InheritFrom(const CPU &parent, double mutation_rate)
+  {
+    if (&parent != this)
+      program = parent.program;
+    Reset();
+    Mutate(mutation_rate);
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Stops all running cores and reloads the program, but keeps the
+   * state. Used when resuming from a checkpoint, since core state can't be saved.
+   */
+  void RestartCores()
+  {
+    cpu.Reset();
+    InitializeState();
+  }
+
   /**
    * Input: The number of CPU cycles to run.
    *
@@ -84,16 +115,16 @@ public:
   }
 
   /**
-   * Input: None
+   * Input: The mutation rate
    *
    * Output: None
    *
    * Purpose: Mutates the genome code stored in the CPU.
    */
-  void Mutate()
+  void Mutate(double mutation_rate)
   {
     InitializeState();
-    program.ApplyPointMutations(worldConfig.MUTATION_RATE());
+    program.ApplyPointMutations(mutation_rate);
     // Probability each genome bit is flipped
   }
 
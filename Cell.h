@@ -1,55 +1,154 @@
 #ifndef CELL_H
 #define CELL_H
 
-#include <string>
-#include "emp/math/Random.hpp"
-#include "emp/math/math.hpp"
-#include "emp/Evolve/World_structure.hpp"
-#include "ConfigSetup.h"
-#include "World.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
-class Cell
+/**
+ * All cells of the world, stored as parallel arrays indexed by the cell's
+ * linear index (x * height + y, the same index organisms are placed at).
+ * Neighbours are computed from the index instead of being stored, so a cell
+ * costs 5 bytes and a bit.
+ */
+class CellGrid
 {
-    const MyConfigType &config;
-    emp::Random random;
-    unsigned int id;
-    int linear_index;
-    std::vector<Cell *> connections;
-    int facing;
-    bool has_org;
+public:
+  // direction‐vectors for 8 neighbors (0-N to 7-NW):
+  static constexpr int dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+  static constexpr int dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+private:
+  int width = 0;
+  int height = 0;
+  std::vector<unsigned int> ids;
+  std::vector<uint8_t> facings;
+  // One bit per cell. Deaths during the parallel update clear bits of cells in
+  // different tiles that can share a word, so the words are atomic. Facings are
+  // bytes, so neighbouring cells never share a write there.
+  std::unique_ptr<std::atomic<uint64_t>[]> occupied;
 
 public:
-    Cell(const MyConfigType &cfg = worldConfig) : 
-    config(cfg), random(cfg.SEED()), 
-    id(0), 
-    linear_index(0),
-    connections(std::vector<Cell *>(8)),
-    has_org(false),
-    facing(0)
+  void Resize(int _width, int _height)
+  {
+    width = _width;
+    height = _height;
+    ids.assign(width * height, 0);
+    facings.assign(width * height, 0);
+    occupied.reset(new std::atomic<uint64_t>[(width * height + 63) / 64]());
+  }
+
+  int GetWidth() const { return width; }
+  int GetHeight() const { return height; }
+  size_t GetSize() const { return ids.size(); }
+
+  unsigned int GetID(size_t idx) const { return ids[idx]; }
+  const std::vector<unsigned int> &GetIDs() const { return ids; }
+  void SetID(size_t idx, unsigned int new_id) { ids[idx] = new_id; }
+
+  int GetFacing(size_t idx) const { return facings[idx]; }
+  const std::vector<uint8_t> &GetFacings() const { return facings; }
+  void SetFacing(size_t idx, int new_facing) { facings[idx] = static_cast<uint8_t>(new_facing & 7); }
+
+  bool GetHasOrg(size_t idx) const
+  {
+    return (occupied[idx >> 6].load(std::memory_order_relaxed) >> (idx & 63)) & 1;
+  }
+  void SetHasOrg(size_t idx, bool state)
+  {
+    if (state)
+      occupied[idx >> 6].fetch_or(uint64_t(1) << (idx & 63), std::memory_order_relaxed);
+    else
+      occupied[idx >> 6].fetch_and(~(uint64_t(1) << (idx & 63)), std::memory_order_relaxed);
+  }
+
+  // Whether any of the 8 cells around a cell holds an organism
+  bool HasOccupiedNeighbor(size_t idx) const
+  {
+    for (int dir = 0; dir < 8; ++dir)
     {
-        ;
+      if (GetHasOrg(GetNeighbor(idx, dir)))
+        return true;
     }
+    return false;
+  }
 
-    // Local variables handling
-    void SetID(unsigned int new_id) {id = new_id;}
-    unsigned int GetID() { return id; }
-    int GetIndex() { 
-        return linear_index; 
-    }
-    void SetIndex(int new_idx) { linear_index = new_idx; }
-    int GetFacing() { return facing; }
-    void SetFacing(int new_facing) { facing = new_facing; }
-    void RotateLeft() { facing = emp::Mod(facing - 1, 8); }
-    void RotateRight() { facing = emp::Mod(facing + 1, 8); }
-
-    Cell *GetConnection(int dir) { 
-        return connections[dir]; 
+  /**
+   * Input: A function taking a cell linear index
+   *
+   * Output: None
+   *
+   * Purpose: Visit the occupied cells in index order. Whole words of empty
+   * cells are skipped, so sparse worlds cost little more than their organisms.
+   */
+  template <typename FUN>
+  void ForEachOccupied(FUN fn) const
+  {
+    const size_t num_words = (ids.size() + 63) / 64;
+    for (size_t w = 0; w < num_words; ++w)
+    {
+      for (uint64_t bits = occupied[w].load(std::memory_order_relaxed); bits; bits &= bits - 1)
+        fn(w * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
     }
-    void SetConnection(int dir, Cell *new_connection) { connections[dir] = new_connection; }
-    Cell *GetFacingCell() {return GetConnection(GetFacing());}
+  }
+
+  /**
+   * Input: A cell linear index and a direction (0-N to 7-NW)
+   *
+   * Output: The linear index of the neighbouring cell, wrapping around the edges
+   *
+   * Purpose: Replaces the per-cell table of neighbour pointers.
+   */
+  size_t GetNeighbor(size_t idx, int dir) const
+  {
+    int x = static_cast<int>(idx) / height + dx[dir];
+    int y = static_cast<int>(idx) % height + dy[dir];
+    if (x < 0)
+      x += width;
+    else if (x >= width)
+      x -= width;
+    if (y < 0)
+      y += height;
+    else if (y >= height)
+      y -= height;
+    return static_cast<size_t>(x) * height + y;
+  }
+};
+
+/**
+ * A handle to one cell of a CellGrid. Cheap to copy; a default constructed
+ * handle refers to no cell.
+ */
+class Cell
+{
+  CellGrid *grid = nullptr;
+  size_t index = 0;
+
+public:
+  Cell() = default;
+  Cell(CellGrid *_grid, size_t _index) : grid(_grid), index(_index) { ; }
+
+  explicit operator bool() const { return grid != nullptr; }
+  bool operator==(const Cell &other) const { return grid == other.grid && index == other.index; }
+  bool operator!=(const Cell &other) const { return !(*this == other); }
+
+  // Local variables handling
+  void SetID(unsigned int new_id) { grid->SetID(index, new_id); }
+  unsigned int GetID() const { return grid->GetID(index); }
+  int GetIndex() const { return static_cast<int>(index); }
+  int GetFacing() const { return grid->GetFacing(index); }
+  void SetFacing(int new_facing) { grid->SetFacing(index, new_facing); }
+  void RotateLeft() { SetFacing(GetFacing() - 1); }
+  void RotateRight() { SetFacing(GetFacing() + 1); }
+
+  Cell GetConnection(int dir) const { return Cell(grid, grid->GetNeighbor(index, dir)); }
+  Cell GetFacingCell() const { return GetConnection(GetFacing()); }
 
-    bool GetHasOrg(){return has_org;}
-    void SetHasOrg(bool state){has_org = state;}
+  bool GetHasOrg() const { return grid->GetHasOrg(index); }
+  bool HasOccupiedNeighbor() const { return grid->HasOccupiedNeighbor(index); }
+  void SetHasOrg(bool state) { grid->SetHasOrg(index, state); }
 };
 
-#endif
\ No newline at end of file
+#endif
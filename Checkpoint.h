@@ -0,0 +1,165 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Appends plain values to an in-memory checkpoint image. Values are stored in
+ * host byte order, so a checkpoint is only meant to be read back by the same
+ * build on the same kind of machine.
+ */
+class CheckpointWriter
+{
+  std::string bytes;
+
+public:
+  void PutRaw(const void *data, size_t size)
+  {
+    bytes.append(static_cast<const char *>(data), size);
+  }
+
+  template <typename T>
+  void Put(const T &value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Put only takes plain values");
+    PutRaw(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void PutVector(const std::vector<T> &values)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "PutVector only takes plain values");
+    Put<uint64_t>(values.size());
+    PutRaw(values.data(), values.size() * sizeof(T));
+  }
+
+  void PutString(const std::string &str)
+  {
+    Put<uint64_t>(str.size());
+    PutRaw(str.data(), str.size());
+  }
+
+  std::string &GetBytes() { return bytes; }
+};
+
+/**
+ * Reads values back in the order a CheckpointWriter put them. Running past the
+ * end marks the reader as failed instead of reading garbage.
+ */
+class CheckpointReader
+{
+  std::string bytes;
+  size_t pos = 0;
+  bool ok = true;
+
+public:
+  CheckpointReader(const std::string &filename)
+  {
+    std::ifstream in(filename, std::ios::binary);
+    ok = static_cast<bool>(in);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  bool IsOk() const { return ok; }
+
+  void GetRaw(void *data, size_t size)
+  {
+    if (!ok || bytes.size() - pos < size)
+    {
+      ok = false;
+      std::memset(data, 0, size);
+      return;
+    }
+    if (size)
+      std::memcpy(data, bytes.data() + pos, size);
+    pos += size;
+  }
+
+  template <typename T>
+  T Get()
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Get only returns plain values");
+    T value;
+    GetRaw(&value, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> GetVector()
+  {
+    const uint64_t size = Get<uint64_t>();
+    std::vector<T> values;
+    if (!ok || size > (bytes.size() - pos) / sizeof(T))
+    {
+      ok = false;
+      return values;
+    }
+    values.resize(size);
+    GetRaw(values.data(), size * sizeof(T));
+    return values;
+  }
+
+  std::string GetString()
+  {
+    const uint64_t size = Get<uint64_t>();
+    if (!ok || size > bytes.size() - pos)
+    {
+      ok = false;
+      return "";
+    }
+    std::string str = bytes.substr(pos, size);
+    pos += size;
+    return str;
+  }
+};
+
+/**
+ * Writes checkpoint images to disk on a background thread. The image goes to
+ * a temporary file that is renamed over the target once complete, so a crash
+ * mid-write never leaves a truncated checkpoint behind.
+ */
+class AsyncFileWriter
+{
+  std::thread thread;
+
+public:
+  ~AsyncFileWriter() { Wait(); }
+
+  void Wait()
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+
+  /**
+   * Input: The target filename and the bytes to write.
+   *
+   * Output: None
+   *
+   * Purpose: Start writing in the background, after any previous write is done.
+   */
+  void Write(const std::string &filename, std::string &&bytes)
+  {
+    Wait();
+    thread = std::thread([filename, data = std::move(bytes)]()
+                         {
+      const std::string tmp = filename + ".tmp";
+      {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), data.size());
+        if (!out)
+          return;
+      }
+      std::rename(tmp.c_str(), filename.c_str()); });
+  }
+};
+
+#endif
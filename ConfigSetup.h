@@ -19,6 +19,33 @@ EMP_BUILD_CONFIG(MyConfigType,
     VALUE(MUTATION_RATE, float, 0.0075, "How likely wil each genome bit will be mutated?"),
     VALUE(MAX_BRIGHT,    float,   1,   "How bright (0-1) is the orgainsm with the most points?" ),
     VALUE(MIN_BRIGHT,    float, 0.8,   "How bright (0-1) is the orgainsm with the least points?" ),
+    VALUE(UPDATES_PER_FRAME, int, 1, "How many updates does the web view run per frame?"),
+    VALUE(PANEL_FREQUENCY, int, 10, "How many frames of the web view between refreshes of its stats panels?"),
+    VALUE(CPU_CYCLES, int, 10, "How many CPU cycles does an organism run per update (before CPU_BUDGET scaling)?"),
+    VALUE(CPU_BUDGET, std::string, "fixed", "How are CPU cycles handed out: fixed, task (times 1 + hardest task solved) or points (times points over an ancestor's 30)"),
+    VALUE(CPU_MAX_CYCLES, int, 1000, "Most cycles a task or points budget can give one organism per update"),
+    VALUE(ISOLATED_BATCH, int, 1, "Organisms with no neighbours save up this many updates of cycles and run them in one go (1 runs every update)"),
+    VALUE(INBOX_CAPACITY, int, 0, "How many messages can each organism's inbox queue? (0 keeps the single inbox that every send overwrites)"),
+    VALUE(SCHEDULE, std::string, "legacy", "Order of the serial update: legacy (random over all cells), random, sequential or checkerboard (over live organisms)"),
+    VALUE(THREAD_NUM, int, 0, "How many threads should run the tiled parallel update? (0 keeps the original serial update)"),
+    VALUE(TILE_SIZE, int, 8, "How many cells across is each tile of the parallel update? (at least 2)"),
+    VALUE(DETERMINISTIC, bool, true, "Should the parallel update give the same results for any THREAD_NUM?"),
+    VALUE(DATA_FORMAT, std::string, "csv", "Format of the native data files: csv, or binary for sparse files readable with sparse_to_csv"),
+    VALUE(BATCH_FILE, std::string, "", "Sweep file of settings to run as a batch of native runs (empty does a single run)"),
+    VALUE(BATCH_THREADS, int, 0, "How many batch runs should run at once? (0 uses one per hardware thread)"),
+    VALUE(CHECKPOINT_FILE, std::string, "checkpoint.bin", "Where should native runs write their checkpoints?"),
+    VALUE(CHECKPOINT_FREQUENCY, int, 0, "How many updates between checkpoints? (0 turns checkpoints off)"),
+    VALUE(RESUME_FILE, std::string, "", "Checkpoint to resume a native run from (empty starts a new run)"),
+    VALUE(TRACE_FILE, std::string, "", "Binary file to trace every message send and retrieve into (empty turns tracing off)"),
+    VALUE(TRACE_BUFFER, int, 65536, "How many trace records can each thread buffer before waiting on the writer?"),
+    VALUE(PROGRESS_INTERVAL, double, 10, "How many seconds between progress reports of native runs? (0 turns them off)"),
+    VALUE(STOP_ON_EXTINCTION, bool, true, "Should native runs stop early once every organism has died? If not, the empty updates are skipped"),
+    VALUE(QUIESCENT_WINDOW, int, 0, "Stop native runs after this many updates in a row without births, deaths or messages (0 turns this off)"),
+    VALUE(STOP_SOLVE_RATE, double, 0, "Stop native runs once this share of organisms solve STOP_SOLVE_TASK at least once in one update (0 turns this off)"),
+    VALUE(STOP_SOLVE_TASK, int, -1, "Task index for STOP_SOLVE_RATE (-1 is the last task)"),
+    VALUE(MAX_WALL_SECONDS, double, 0, "Stop native runs after this many seconds of wall-clock time (0 for no limit)"),
+    VALUE(PROFILE_FILE, std::string, "", "CSV file for the per-phase update profile (empty turns profiling off)"),
+    VALUE(PROFILE_FREQUENCY, int, 100, "How many updates does each row of the update profile cover?"),
 )
 
 extern MyConfigType worldConfig;
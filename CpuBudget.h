@@ -0,0 +1,85 @@
+#ifndef CPUBUDGET_H
+#define CPUBUDGET_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include "ConfigSetup.h"
+#include "OrgState.h"
+
+// How an organism's CPU cycles per update are worked out
+enum class BudgetPolicy
+{
+  FIXED,  // CPU_CYCLES for everyone
+  TASK,   // CPU_CYCLES * (1 + index of the hardest task solved)
+  POINTS  // CPU_CYCLES * points / ANCESTOR_POINTS
+};
+
+/**
+ * The execution budget of organisms, read from the config once so that
+ * Organism::Process doesn't parse settings on every call.
+ */
+struct CpuBudget
+{
+  // Points of a new ancestor, which earns exactly CPU_CYCLES under POINTS
+  static constexpr double ANCESTOR_POINTS = 30.0;
+
+  BudgetPolicy policy = BudgetPolicy::FIXED;
+  size_t cycles = 10;
+  size_t max_cycles = 1000;
+  // Updates an organism without neighbours banks before running them at once
+  size_t isolated_batch = 1;
+
+  /**
+   * Input: The world's config
+   *
+   * Output: None
+   *
+   * Purpose: Read the budget settings. Unknown policies fall back to fixed with a warning.
+   */
+  void Setup(const MyConfigType &config)
+  {
+    const std::string &name = config.CPU_BUDGET();
+    if (name == "task")
+      policy = BudgetPolicy::TASK;
+    else if (name == "points")
+      policy = BudgetPolicy::POINTS;
+    else
+    {
+      if (name != "fixed")
+        std::cerr << "Unknown CPU_BUDGET " << name << ", using fixed" << std::endl;
+      policy = BudgetPolicy::FIXED;
+    }
+    cycles = std::max(config.CPU_CYCLES(), 0);
+    max_cycles = std::max<size_t>(std::max(config.CPU_MAX_CYCLES(), 0), cycles);
+    isolated_batch = std::max(config.ISOLATED_BATCH(), 1);
+  }
+
+  /**
+   * Input: An organism's state
+   *
+   * Output: The cycles it earns this update
+   *
+   * Purpose: Apply the policy. Scaled budgets stay between 1 and max_cycles.
+   */
+  size_t CyclesFor(const OrgState &state) const
+  {
+    double scaled;
+    switch (policy)
+    {
+    case BudgetPolicy::TASK:
+      scaled = static_cast<double>(cycles) * (1 + state.best_task);
+      break;
+    case BudgetPolicy::POINTS:
+      scaled = std::round(cycles * std::max(state.points, 0.0) / ANCESTOR_POINTS);
+      break;
+    default:
+      return cycles;
+    }
+    return static_cast<size_t>(std::clamp(scaled, 1.0, static_cast<double>(max_cycles)));
+  }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * One message event, written to the trace file as-is (32 bytes, host byte
+ * order). For retrievals the "from" fields are unknown and left as -1 / 0.
+ */
+struct TraceRecord
+{
+  uint64_t update;
+  uint8_t kind;
+  // 1 if the message is one of the world's cell IDs
+  uint8_t is_id;
+  uint16_t reserved;
+  int32_t from_idx;
+  uint32_t from_id;
+  int32_t to_idx;
+  uint32_t to_id;
+  uint32_t message;
+};
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must stay a fixed 32 bytes");
+
+enum TraceKind : uint8_t
+{
+  TRACE_SEND = 0,
+  TRACE_RECEIVE = 1
+};
+
+/**
+ * A single-producer single-consumer ring of trace records. The simulation
+ * thread that owns it pushes, the tracer's writer thread drains.
+ */
+class TraceRing
+{
+  std::vector<TraceRecord> buffer;
+  size_t mask;
+  std::atomic<size_t> head{0};
+  std::atomic<size_t> tail{0};
+
+public:
+  // Capacity is rounded up to a power of two
+  TraceRing(size_t capacity)
+  {
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    buffer.resize(size);
+    mask = size - 1;
+  }
+
+  bool TryPush(const TraceRecord &record)
+  {
+    const size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) > mask)
+      return false;
+    buffer[h & mask] = record;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Input: The stream to write to.
+   *
+   * Output: Number of records written.
+   *
+   * Purpose: Move everything currently in the ring to the stream.
+   */
+  size_t Drain(std::ostream &out)
+  {
+    const size_t t = tail.load(std::memory_order_relaxed);
+    const size_t h = head.load(std::memory_order_acquire);
+    size_t pos = t;
+    while (pos != h)
+    {
+      const size_t start = pos & mask;
+      const size_t count = std::min(h - pos, buffer.size() - start);
+      out.write(reinterpret_cast<const char *>(&buffer[start]), count * sizeof(TraceRecord));
+      pos += count;
+    }
+    tail.store(h, std::memory_order_release);
+    return h - t;
+  }
+};
+
+/**
+ * Opt-in binary trace of message events. Each simulation thread gets its own
+ * ring the first time it records, and a background thread drains the rings
+ * into the file, so the update loop never formats text or touches the disk.
+ * A full ring makes the recording thread wait for the writer rather than drop
+ * events. Records of different threads are interleaved in the file; sort by
+ * update if order matters.
+ *
+ * File layout: the 8 bytes "ORGTRACE", a uint32 version, a uint32 record size,
+ * then back-to-back TraceRecords.
+ */
+class EventTracer
+{
+  struct ThreadRing
+  {
+    std::thread::id owner;
+    std::unique_ptr<TraceRing> ring;
+  };
+
+  const uint64_t tracer_id;
+  const size_t ring_capacity;
+  std::ofstream out;
+  std::mutex rings_mutex;
+  std::vector<ThreadRing> rings;
+  std::mutex wake_mutex;
+  std::condition_variable wake_cv;
+  std::atomic<bool> stopping{false};
+  std::thread writer;
+
+  static uint64_t NextTracerId()
+  {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id++;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The ring of the calling thread.
+   *
+   * Purpose: Find or create the calling thread's ring. The last lookup is
+   * cached per thread so the common case takes no lock.
+   */
+  TraceRing &LocalRing()
+  {
+    thread_local uint64_t cached_tracer = 0;
+    thread_local TraceRing *cached_ring = nullptr;
+    if (cached_tracer == tracer_id)
+      return *cached_ring;
+
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    const std::thread::id self = std::this_thread::get_id();
+    TraceRing *found = nullptr;
+    for (ThreadRing &entry : rings)
+    {
+      if (entry.owner == self)
+        found = entry.ring.get();
+    }
+    if (!found)
+    {
+      rings.push_back(ThreadRing{self, std::make_unique<TraceRing>(ring_capacity)});
+      found = rings.back().ring.get();
+    }
+    cached_tracer = tracer_id;
+    cached_ring = found;
+    return *found;
+  }
+
+  size_t DrainAll()
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    size_t written = 0;
+    for (ThreadRing &entry : rings)
+    {
+      written += entry.ring->Drain(out);
+    }
+    return written;
+  }
+
+  void WriterLoop()
+  {
+    while (!stopping)
+    {
+      if (DrainAll() == 0)
+      {
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        wake_cv.wait_for(lock, std::chrono::milliseconds(5));
+      }
+    }
+  }
+
+public:
+  EventTracer(const std::string &filename, size_t capacity)
+      : tracer_id(NextTracerId()), ring_capacity(std::max<size_t>(capacity, 16)),
+        out(filename, std::ios::binary)
+  {
+    const uint32_t version = 1;
+    const uint32_t record_size = sizeof(TraceRecord);
+    out.write("ORGTRACE", 8);
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char *>(&record_size), sizeof(record_size));
+    writer = std::thread(&EventTracer::WriterLoop, this);
+  }
+
+  ~EventTracer()
+  {
+    stopping = true;
+    wake_cv.notify_one();
+    writer.join();
+    DrainAll();
+    out.flush();
+  }
+
+  /**
+   * Input: The event to record.
+   *
+   * Output: None
+   *
+   * Purpose: Queue an event from any simulation thread.
+   */
+  void Record(const TraceRecord &record)
+  {
+    TraceRing &ring = LocalRing();
+    while (!ring.TryPush(record))
+    {
+      wake_cv.notify_one();
+      std::this_thread::yield();
+    }
+  }
+};
+
+#endif
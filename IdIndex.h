@@ -0,0 +1,126 @@
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Maps cell IDs to cell indices. The IDs are fixed once the grid is set up, so
+ * the table is built once: a flat open-addressing table with linear probing,
+ * at most half full, where every slot is 8 bytes. A lookup is one multiply and
+ * usually a single cache line, with no pointer chasing.
+ */
+class IdIndex
+{
+  struct Slot
+  {
+    uint32_t id;
+    // Cell index, or -1 for an empty slot (0 is a valid ID)
+    int32_t idx;
+  };
+
+  std::vector<Slot> slots;
+  uint32_t mask = 0;
+  uint32_t shift = 32;
+  size_t num_ids = 0;
+
+  size_t Home(uint32_t id) const
+  {
+    return static_cast<uint32_t>(id * 0x9E3779B1u) >> shift;
+  }
+
+public:
+  /**
+   * Input: The ID of every cell, by cell index
+   *
+   * Output: None
+   *
+   * Purpose: Build the table. If two cells share an ID the later one wins.
+   */
+  void Build(const std::vector<unsigned int> &cell_ids)
+  {
+    size_t capacity = 2;
+    shift = 31;
+    while (capacity < cell_ids.size() * 2)
+    {
+      capacity <<= 1;
+      --shift;
+    }
+    mask = static_cast<uint32_t>(capacity - 1);
+    slots.assign(capacity, Slot{0, -1});
+    num_ids = 0;
+
+    for (size_t idx = 0; idx < cell_ids.size(); ++idx)
+    {
+      const uint32_t id = cell_ids[idx];
+      size_t pos = Home(id);
+      while (slots[pos].idx >= 0 && slots[pos].id != id)
+        pos = (pos + 1) & mask;
+      if (slots[pos].idx < 0)
+        ++num_ids;
+      slots[pos] = Slot{id, static_cast<int32_t>(idx)};
+    }
+  }
+
+  size_t size() const { return num_ids; }
+
+  // Cell index of a value, or -1 if it isn't a cell ID
+  int Find(uint32_t value) const
+  {
+    if (slots.empty())
+      return -1;
+    for (size_t pos = Home(value);; pos = (pos + 1) & mask)
+    {
+      const Slot &slot = slots[pos];
+      if (slot.idx < 0 || slot.id == value)
+        return slot.idx;
+    }
+  }
+
+  bool Contains(uint32_t value) const { return Find(value) >= 0; }
+
+  /**
+   * Input: A batch of values, their count, and where to write the results
+   *
+   * Output: None
+   *
+   * Purpose: Find the cell index (or -1) of many values at once. The home
+   * slots of the whole batch are computed and prefetched first, so their
+   * memory loads overlap instead of waiting on each other one lookup at a time.
+   */
+  void Classify(const uint32_t *values, int *out, size_t count) const
+  {
+    constexpr size_t BLOCK = 16;
+    size_t home[BLOCK];
+    for (size_t start = 0; start < count; start += BLOCK)
+    {
+      const size_t n = (count - start < BLOCK) ? count - start : BLOCK;
+      for (size_t i = 0; i < n && !slots.empty(); ++i)
+      {
+        home[i] = Home(values[start + i]);
+        __builtin_prefetch(&slots[home[i]]);
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (slots.empty())
+        {
+          out[start + i] = -1;
+          continue;
+        }
+        const uint32_t value = values[start + i];
+        for (size_t pos = home[i];; pos = (pos + 1) & mask)
+        {
+          const Slot &slot = slots[pos];
+          if (slot.idx < 0 || slot.id == value)
+          {
+            out[start + i] = slot.idx;
+            break;
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
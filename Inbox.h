@@ -0,0 +1,108 @@
+#ifndef INBOX_H
+#define INBOX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Bounded message inboxes for every cell of the world (INBOX_CAPACITY > 0).
+ * All inboxes share one contiguous buffer with `capacity` slots per cell, used
+ * as a ring, so no organism owns any heap memory for its messages. An inbox
+ * belongs to the cell rather than the organism: the world clears it whenever
+ * an organism is placed in the cell.
+ *
+ * Messages are never 0 (SendMessage doesn't send 0), so 0 stands for "empty".
+ */
+class InboxRing
+{
+  size_t capacity = 0;
+  std::vector<uint32_t> slots;
+  // Per cell, the slot offset of the oldest message and how many are queued
+  std::vector<uint32_t> heads;
+  std::vector<uint32_t> counts;
+
+public:
+  /**
+   * Input: The number of cells and the messages each inbox can hold
+   *
+   * Output: None
+   *
+   * Purpose: Allocate every inbox, all empty. A capacity of 0 leaves them unused.
+   */
+  void Setup(size_t num_cells, size_t _capacity)
+  {
+    capacity = _capacity;
+    slots.assign(capacity ? num_cells * capacity : 0, 0);
+    heads.assign(capacity ? num_cells : 0, 0);
+    counts.assign(capacity ? num_cells : 0, 0);
+  }
+
+  bool IsEnabled() const { return capacity > 0; }
+  size_t GetCapacity() const { return capacity; }
+  size_t GetCount(size_t cell) const { return counts[cell]; }
+
+  void Clear(size_t cell)
+  {
+    heads[cell] = 0;
+    counts[cell] = 0;
+  }
+
+  // The oldest message in a cell's inbox, or 0 if it is empty
+  uint32_t Front(size_t cell) const
+  {
+    return counts[cell] ? slots[cell * capacity + heads[cell]] : 0;
+  }
+
+  /**
+   * Input: A cell index and a message
+   *
+   * Output: Whether the message was queued; false if the inbox is full
+   *
+   * Purpose: Add a message to the back of a cell's inbox.
+   */
+  bool Push(size_t cell, uint32_t message)
+  {
+    if (counts[cell] == capacity)
+      return false;
+    size_t slot = heads[cell] + counts[cell];
+    if (slot >= capacity)
+      slot -= capacity;
+    slots[cell * capacity + slot] = message;
+    ++counts[cell];
+    return true;
+  }
+
+  /**
+   * Input: A cell index
+   *
+   * Output: The oldest message, or 0 if the inbox is empty
+   *
+   * Purpose: Take the oldest message out of a cell's inbox.
+   */
+  uint32_t Pop(size_t cell)
+  {
+    if (!counts[cell])
+      return 0;
+    const uint32_t message = slots[cell * capacity + heads[cell]];
+    if (++heads[cell] == capacity)
+      heads[cell] = 0;
+    --counts[cell];
+    return message;
+  }
+
+  // The queued messages of a cell, oldest first, e.g. to save them
+  std::vector<uint32_t> GetMessages(size_t cell) const
+  {
+    std::vector<uint32_t> messages;
+    for (size_t i = 0, slot = heads[cell]; i < counts[cell]; ++i)
+    {
+      messages.push_back(slots[cell * capacity + slot]);
+      if (++slot == capacity)
+        slot = 0;
+    }
+    return messages;
+  }
+};
+
+#endif
@@ -82,7 +82,7 @@ struct GetFacing {
     static void run(sgpl::Core<Spec> &core, const sgpl::Instruction<Spec> &inst,
                   const sgpl::Program<Spec> &,
                   typename Spec::peripheral_t &state) noexcept {
-        core.registers[inst.args[0]] = state.cell->GetFacing();
+        core.registers[inst.args[0]] = state.cell.GetFacing();
     }
 
     static std::string name() { return "GetFacing"; } 
@@ -94,7 +94,7 @@ struct RotateLeft {
     static void run(sgpl::Core<Spec> &core, const sgpl::Instruction<Spec> &inst,
                   const sgpl::Program<Spec> &,
                   typename Spec::peripheral_t &state) noexcept {
-        state.cell->RotateLeft();
+        state.cell.RotateLeft();
     }
 
     static std::string name() { return "RotateLeft"; } 
@@ -106,7 +106,7 @@ struct RotateRight {
     static void run(sgpl::Core<Spec> &core, const sgpl::Instruction<Spec> &inst,
                   const sgpl::Program<Spec> &,
                   typename Spec::peripheral_t &state) noexcept {
-        state.cell->RotateRight();
+        state.cell.RotateRight();
     }
 
     static std::string name() { return "RotateRight"; } 
@@ -119,7 +119,7 @@ struct GetID {
                   const sgpl::Program<Spec> &,
                   typename Spec::peripheral_t &state) noexcept {
         
-        core.registers[inst.args[0]] = state.cell->GetID();
+        core.registers[inst.args[0]] = state.cell.GetID();
     }
 
     static std::string name() { return "GetID"; } 
@@ -0,0 +1,235 @@
+#ifndef KNOWNIDSET_H
+#define KNOWNIDSET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * The values an organism has retrieved. Values are kept in a small sorted
+ * inline array. Once that is full, values that are cell IDs move into a bitset
+ * over the cell indices (allocated once, then kept for the life of the
+ * organism's storage), which can hold every ID in the world. Values that
+ * aren't IDs stay in the inline array, and once it is full of them further
+ * ones go to an open-addressed hash table, so every value is remembered
+ * exactly, as the unordered_set this replaces did.
+ *
+ * Memory is therefore not bounded: the table grows with the number of
+ * distinct non-ID values an organism retrieves. Non-IDs are common, since
+ * organisms send whatever is in their registers, and SendNonID/SendID score an
+ * organism on whether a value is new to it. Forgetting values past a cap would
+ * change which sends earn points, so exact membership wins over a memory bound.
+ *
+ * Callers pass a value together with its cell index (-1 for non-IDs), which the
+ * world has already looked up, so membership tests never hash.
+ */
+class KnownIDSet
+{
+public:
+  static constexpr size_t INLINE_CAPACITY = 8;
+
+private:
+  struct Entry
+  {
+    unsigned int value;
+    int cell_idx;
+  };
+
+  Entry entries[INLINE_CAPACITY];
+  uint32_t count = 0;
+  uint32_t num_words = 0;
+  std::unique_ptr<uint64_t[]> id_bits;
+  // Values that aren't IDs, past the inline array: a linear-probing table of
+  // value + 1 (0 marks an empty slot), a power of two in size, at most half full
+  std::vector<uint64_t> overflow;
+  uint32_t num_overflow = 0;
+
+  bool TestBit(int cell_idx) const
+  {
+    return (id_bits[cell_idx >> 6] >> (cell_idx & 63)) & 1;
+  }
+
+  void SetBit(int cell_idx)
+  {
+    id_bits[cell_idx >> 6] |= uint64_t(1) << (cell_idx & 63);
+  }
+
+  // Slot holding `value` in the overflow table, or the empty slot where it would go
+  size_t FindSlot(unsigned int value) const
+  {
+    const size_t mask = overflow.size() - 1;
+    size_t slot = static_cast<size_t>((value * uint64_t(0x9E3779B97F4A7C15)) >> 32) & mask;
+    while (overflow[slot] && overflow[slot] != uint64_t(value) + 1)
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  void AddOverflow(unsigned int value)
+  {
+    if (2 * (num_overflow + 1) > overflow.size())
+    {
+      std::vector<uint64_t> old(std::max<size_t>(16, 2 * overflow.size()), 0);
+      old.swap(overflow);
+      for (uint64_t stored : old)
+      {
+        if (stored)
+          overflow[FindSlot(static_cast<unsigned int>(stored - 1))] = stored;
+      }
+    }
+    overflow[FindSlot(value)] = uint64_t(value) + 1;
+    ++num_overflow;
+  }
+
+  /**
+   * Input: The number of cells in the world
+   *
+   * Output: None
+   *
+   * Purpose: Switch IDs over to the bitset, making room in the inline array.
+   */
+  void SpillIDs(size_t num_cells)
+  {
+    if (!id_bits)
+    {
+      num_words = static_cast<uint32_t>((num_cells + 63) / 64);
+      id_bits.reset(new uint64_t[num_words]());
+    }
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      if (entries[i].cell_idx >= 0)
+        SetBit(entries[i].cell_idx);
+      else
+        entries[kept++] = entries[i];
+    }
+    count = kept;
+  }
+
+public:
+  KnownIDSet() = default;
+  KnownIDSet(const KnownIDSet &other) { *this = other; }
+  // Assigning an empty set clears this one but keeps its bitset and overflow storage
+  KnownIDSet &operator=(const KnownIDSet &other)
+  {
+    if (this == &other)
+      return *this;
+    std::copy(other.entries, other.entries + other.count, entries);
+    count = other.count;
+    if (other.id_bits)
+    {
+      if (num_words != other.num_words)
+      {
+        num_words = other.num_words;
+        id_bits.reset(new uint64_t[num_words]);
+      }
+      std::memcpy(id_bits.get(), other.id_bits.get(), num_words * sizeof(uint64_t));
+    }
+    else if (id_bits)
+    {
+      std::memset(id_bits.get(), 0, num_words * sizeof(uint64_t));
+    }
+    overflow = other.overflow;
+    num_overflow = other.num_overflow;
+    return *this;
+  }
+
+  /**
+   * Input: A value, its cell index (-1 if it isn't a cell ID) and the number of cells
+   *
+   * Output: None
+   *
+   * Purpose: Remember a retrieved value.
+   */
+  void Insert(unsigned int value, int cell_idx, size_t num_cells)
+  {
+    if (Contains(value, cell_idx))
+      return;
+    if (cell_idx >= 0 && id_bits)
+    {
+      SetBit(cell_idx);
+      return;
+    }
+    if (count == INLINE_CAPACITY)
+    {
+      SpillIDs(num_cells);
+      if (cell_idx >= 0)
+      {
+        SetBit(cell_idx);
+        return;
+      }
+      // Full of values that aren't IDs
+      if (count == INLINE_CAPACITY)
+      {
+        AddOverflow(value);
+        return;
+      }
+    }
+    Entry *pos = std::lower_bound(entries, entries + count, value,
+                                  [](const Entry &entry, unsigned int v)
+                                  { return entry.value < v; });
+    std::move_backward(pos, entries + count, entries + count + 1);
+    *pos = Entry{value, cell_idx};
+    ++count;
+  }
+
+  /**
+   * Input: A value and its cell index (-1 if it isn't a cell ID)
+   *
+   * Output: Whether the value has been retrieved before
+   *
+   * Purpose: Membership test, a bit test for IDs once the bitset is in use.
+   */
+  bool Contains(unsigned int value, int cell_idx) const
+  {
+    if (cell_idx >= 0 && id_bits && TestBit(cell_idx))
+      return true;
+    for (uint32_t i = 0; i < count && entries[i].value <= value; ++i)
+    {
+      if (entries[i].value == value)
+        return true;
+    }
+    return cell_idx < 0 && num_overflow && overflow[FindSlot(value)];
+  }
+
+  // Forget everything, keeping the bitset's and table's storage for reuse
+  void Clear()
+  {
+    count = 0;
+    if (num_overflow)
+      std::fill(overflow.begin(), overflow.end(), 0);
+    num_overflow = 0;
+    if (id_bits)
+      std::memset(id_bits.get(), 0, num_words * sizeof(uint64_t));
+  }
+
+  /**
+   * Input: The cell IDs by cell index, and a function taking each value and its cell index
+   *
+   * Output: None
+   *
+   * Purpose: Visit every remembered value, e.g. to save it.
+   */
+  template <typename FUN>
+  void ForEach(const std::vector<unsigned int> &cell_ids, FUN fn) const
+  {
+    for (uint32_t i = 0; i < count; ++i)
+      fn(entries[i].value, entries[i].cell_idx);
+    for (uint64_t stored : overflow)
+    {
+      if (stored)
+        fn(static_cast<unsigned int>(stored - 1), -1);
+    }
+    if (!id_bits)
+      return;
+    for (size_t idx = 0; idx < cell_ids.size(); ++idx)
+    {
+      if (TestBit(static_cast<int>(idx)))
+        fn(cell_ids[idx], static_cast<int>(idx));
+    }
+  }
+};
+
+#endif
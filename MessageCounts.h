@@ -0,0 +1,94 @@
+#ifndef MESSAGECOUNTS_H
+#define MESSAGECOUNTS_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * Counts per message bin (bin 0 is "Other", bin b is the cell with linear
+ * index b - 1), kept as a flat array plus the list of bins touched so far.
+ * Clearing only visits the touched bins, so it costs O(active bins) rather
+ * than O(cells).
+ */
+class SparseCounter
+{
+  std::vector<int> counts;
+  std::vector<int> active;
+
+public:
+  void Resize(size_t num_bins)
+  {
+    counts.assign(num_bins, 0);
+    active.clear();
+  }
+
+  void Add(int bin, int amount = 1)
+  {
+    if (counts[bin] == 0)
+      active.push_back(bin);
+    counts[bin] += amount;
+  }
+
+  int Get(int bin) const { return counts[bin]; }
+  size_t GetNumBins() const { return counts.size(); }
+
+  // Bins with a non-zero count, in the order they were first hit
+  const std::vector<int> &GetActive() const { return active; }
+
+  void Clear()
+  {
+    for (int bin : active)
+      counts[bin] = 0;
+    active.clear();
+  }
+
+  void Swap(SparseCounter &other)
+  {
+    counts.swap(other.counts);
+    active.swap(other.active);
+  }
+};
+
+/**
+ * Message counts for the update in progress, plus the finished counts of the
+ * previous update that data files and the web panels read from.
+ */
+class MessageCounts
+{
+  SparseCounter current;
+  SparseCounter last;
+
+public:
+  void Resize(size_t num_bins)
+  {
+    current.Resize(num_bins);
+    last.Resize(num_bins);
+  }
+
+  void Add(int bin, int amount = 1) { current.Add(bin, amount); }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Publish the counts of the update that just ended and start a fresh one.
+   */
+  void Rollover()
+  {
+    last.Clear();
+    last.Swap(current);
+  }
+
+  void Clear()
+  {
+    current.Clear();
+    last.Clear();
+  }
+
+  const SparseCounter &GetCurrent() const { return current; }
+  const SparseCounter &GetLast() const { return last; }
+  int GetLast(int bin) const { return last.Get(bin); }
+};
+
+#endif
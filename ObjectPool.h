@@ -0,0 +1,167 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "emp/base/Ptr.hpp"
+
+/**
+ * Occupancy of an ObjectPool, for data files and the web view.
+ */
+struct PoolStats
+{
+  size_t capacity = 0;
+  // Objects alive right now, in the pool or (past capacity) on the heap
+  size_t in_use = 0;
+  size_t peak_in_use = 0;
+  size_t acquired = 0;
+  size_t released = 0;
+  // Objects that had to go to the heap because the pool was full
+  size_t overflow = 0;
+};
+
+/**
+ * Fixed block of storage for up to `capacity` objects plus free-lists of the
+ * unused slots. Acquire and Release never touch the allocator while the pool
+ * has room; past that it falls back to the heap. Not thread-safe.
+ *
+ * Released objects are not destroyed. Their slots are kept as idle objects
+ * that AcquireIdle hands out again as they were, so whatever they own (e.g.
+ * an organism's program and cores) can be reinitialized in place instead of
+ * being freed and allocated again. Objects still in their slots when the pool
+ * goes away are destroyed with it.
+ */
+template <typename T>
+class ObjectPool
+{
+  struct alignas(T) Slot
+  {
+    unsigned char bytes[sizeof(T)];
+  };
+
+  std::unique_ptr<Slot[]> slots;
+  size_t capacity = 0;
+  // Slots that have never held an object, and slots holding an idle one
+  std::vector<uint32_t> free_slots;
+  std::vector<uint32_t> idle_slots;
+  std::vector<bool> constructed;
+  PoolStats stats;
+
+  T *SlotPtr(size_t slot) { return std::launder(reinterpret_cast<T *>(slots[slot].bytes)); }
+
+  // Index of the slot holding `obj`, or capacity if it isn't from the pool
+  size_t SlotOf(const T *obj) const
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(slots.get());
+    if (addr < begin || addr >= begin + capacity * sizeof(Slot))
+      return capacity;
+    return (addr - begin) / sizeof(Slot);
+  }
+
+  void CountAcquire()
+  {
+    ++stats.acquired;
+    if (++stats.in_use > stats.peak_in_use)
+      stats.peak_in_use = stats.in_use;
+  }
+
+public:
+  explicit ObjectPool(size_t _capacity)
+      : slots(new Slot[_capacity]), capacity(_capacity), constructed(_capacity, false)
+  {
+    stats.capacity = capacity;
+    free_slots.reserve(capacity);
+    idle_slots.reserve(capacity);
+    // Hand out low slots first
+    for (size_t slot = capacity; slot-- > 0;)
+      free_slots.push_back(static_cast<uint32_t>(slot));
+  }
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  ~ObjectPool()
+  {
+    for (size_t slot = 0; slot < capacity; ++slot)
+    {
+      if (constructed[slot])
+        SlotPtr(slot)->~T();
+    }
+  }
+
+  /**
+   * Input: The constructor arguments
+   *
+   * Output: The new object
+   *
+   * Purpose: Construct an object in a free slot, or on the heap if there is none.
+   * Empty slots are used first; after that an idle object is destroyed to make room.
+   */
+  template <typename... ARGS>
+  emp::Ptr<T> Acquire(ARGS &&...args)
+  {
+    CountAcquire();
+    std::vector<uint32_t> &from = free_slots.empty() ? idle_slots : free_slots;
+    if (from.empty())
+    {
+      ++stats.overflow;
+      return emp::NewPtr<T>(std::forward<ARGS>(args)...);
+    }
+    const size_t slot = from.back();
+    if (constructed[slot])
+      SlotPtr(slot)->~T();
+    constructed[slot] = false;
+    T *obj = new (slots[slot].bytes) T(std::forward<ARGS>(args)...);
+    from.pop_back();
+    constructed[slot] = true;
+    return emp::Ptr<T>(obj);
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: A released object, as Release left it, or nullptr if there is none
+   *
+   * Purpose: Reuse an idle object. The caller reinitializes it.
+   */
+  emp::Ptr<T> AcquireIdle()
+  {
+    if (idle_slots.empty())
+      return nullptr;
+    CountAcquire();
+    const size_t slot = idle_slots.back();
+    idle_slots.pop_back();
+    return emp::Ptr<T>(SlotPtr(slot));
+  }
+
+  /**
+   * Input: An object from Acquire
+   *
+   * Output: None
+   *
+   * Purpose: Make the object's slot available again. Pooled objects stay
+   * alive as idle objects; heap ones are deleted.
+   */
+  void Release(emp::Ptr<T> obj)
+  {
+    ++stats.released;
+    --stats.in_use;
+    const size_t slot = SlotOf(obj.Raw());
+    if (slot == capacity)
+    {
+      obj.Delete();
+      return;
+    }
+    idle_slots.push_back(static_cast<uint32_t>(slot));
+  }
+
+  const PoolStats &GetStats() const { return stats; }
+
+};
+
+#endif
@@ -7,17 +7,21 @@
 #include "Cell.h"
 #include "emp/Evolve/World_structure.hpp"
 #include "ConfigSetup.h"
+#include "CpuBudget.h"
 
 class Organism {
   CPU cpu;
   const MyConfigType& config;
 
 public:
-
-  Organism(emp::Ptr<OrgWorld> world, const MyConfigType& cfg = worldConfig, double points = 30.0) : cpu(world), config(cfg) {
+  Organism(emp::Ptr<OrgWorld> world, const MyConfigType& cfg, double points = 30.0) : cpu(world), config(cfg) {
     SetPoints(points);
   }
 
+  Organism(emp::Ptr<OrgWorld> world, const sgpl::Program<Spec>& program, const MyConfigType& cfg) : cpu(world, program), config(cfg) {
+    ;
+  }
+
   // Local variables data processing
   void SetPoints(double _in) { cpu.state.points = _in; }
   void AddPoints(double _in) { cpu.state.points += _in; }
@@ -32,8 +36,8 @@ public:
   void SetReproduced(int new_rep){cpu.state.reproduced = new_rep;}
   int GetReproduced(){return cpu.state.reproduced;}
  
-  void SetCell(Cell* new_cell) {cpu.state.cell = new_cell;}
-  Cell* GetCell() {return cpu.state.cell;}
+  void SetCell(Cell new_cell) {cpu.state.cell = new_cell;}
+  Cell GetCell() {return cpu.state.cell;}
 
   void SetFacing(int new_facing) {cpu.state.facing = new_facing;}
   
@@ -46,42 +50,57 @@ public:
   void SetRetrieved(unsigned int new_retrieved) {cpu.state.retrieved = new_retrieved;}
   unsigned int GetRetrieved() {return cpu.state.retrieved;}
 
-  void AddRetrievedValue(unsigned int new_retrieved_value) {cpu.state.retrieved_values.insert(new_retrieved_value);}
-  void SetRetrievedValues(std::unordered_set<unsigned int> new_retrieved_values) {cpu.state.retrieved_values = new_retrieved_values;}
-  std::unordered_set<unsigned int> GetRetrievedValues() {return cpu.state.retrieved_values;}
+  void AddRetrievedValue(unsigned int new_retrieved_value, int cell_idx, size_t num_cells) {cpu.state.retrieved_values.Insert(new_retrieved_value, cell_idx, num_cells);}
+  const KnownIDSet& GetRetrievedValues() const {return cpu.state.retrieved_values;}
   
   void SetMaxKnown(unsigned int new_max_known) {cpu.state.max_known = new_max_known;}
   unsigned int GetMaxKnown() {return cpu.state.max_known;}
 
+  OrgState& GetState() { return cpu.state; }
+  const sgpl::Program<Spec>& GetProgram() const { return cpu.GetProgram(); }
+
   void Reset() { cpu.Reset(); }
-  void Mutate() { cpu.Mutate(); }
+  void RestartCores() { cpu.RestartCores(); }
+  void Mutate() { cpu.Mutate(config.MUTATION_RATE()); }
 
   /**
-   * Attempt to produce a child organism, if this organism has enough points.
+   * Input: The parent organism (which may be this organism)
+   *
+   * Output: None
+   *
+   * Purpose: Become the parent's mutated offspring, reusing this organism's storage.
    */
-  std::optional<Organism> CheckReproduction() {
-    Organism offspring = *this;
-    offspring.Reset();
-    offspring.Mutate();
-    return offspring;
-  }
+  void InheritFrom(const Organism &parent) { cpu.InheritFrom(parent.cpu, config.MUTATION_RATE()); }
 
   /**
-   * Input: the current index location of the organism.
+   * Input: the current index location of the organism, and the world's CPU budget.
    *
-   * Output: None
+   * Output: The number of CPU cycles run.
    *
-   * Purpose: Add initial points boost, saves the information in the CPU, run the CPU for some cycles, and age up the organism.
+   * Purpose: Add initial points boost, saves the information in the CPU, run the CPU for the cycles the budget gives, and age up the organism.
+   * An organism with no neighbours can bank its cycles and run several updates' worth in one call.
    */
-  void Process(emp::WorldPosition current_location) {
+  size_t Process(emp::WorldPosition current_location, const CpuBudget& budget) {
     if (GetReproduced() < 2) {AddPoints(1.0);}
     cpu.state.current_location = current_location;
-    Cell* cur_cell = cpu.state.cell;
-    cpu.RunCPUStep(10);
+    Cell cur_cell = cpu.state.cell;
+    size_t cycles = budget.CyclesFor(cpu.state);
+    if (budget.isolated_batch > 1) {
+      cycles += cpu.state.banked_cycles;
+      if (++cpu.state.banked_updates < budget.isolated_batch && !cur_cell.HasOccupiedNeighbor()) {
+        cpu.state.banked_cycles = static_cast<uint32_t>(cycles);
+        cycles = 0;
+      } else {
+        cpu.state.banked_cycles = 0;
+        cpu.state.banked_updates = 0;
+      }
+    }
+    if (cycles) {cpu.RunCPUStep(cycles);}
     cpu.state.age++;
     double penalty = std::log10( static_cast<double>(cpu.state.age) + 1.0 ) - 1;
     // Uncomment for penalty expansion
     // AddPoints( -penalty );
+    return cycles;
   }
 
   /**
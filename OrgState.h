@@ -4,7 +4,9 @@
 #include "emp/Evolve/World_structure.hpp"
 #include "Cell.h"
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include "KnownIDSet.h"
 
 // This forward declaration is necessary since the world contains organisms,
 // which contain cpus, which contain the state, so if the state could actually
@@ -27,19 +29,29 @@ struct OrgState {
   //Needs to know current location for possible reproduction
   emp::WorldPosition current_location;
   //Current cell the organism is located in
-  Cell* cell;
+  Cell cell;
   // Current facing direction of the cell (0-N to 7-NW)
   int facing;
   // The message the organism will send
   unsigned int message;
+  // Cell index of the message if it is a cell ID, -1 otherwise. Set by the
+  // world whenever a message is sent, before tasks are checked.
+  int message_idx = -1;
   // The message inbox
   unsigned int inbox;
   // The message retrieved from inbox
   unsigned int retrieved;
-  // All values this organism has retrieved so far
-  std::unordered_set<unsigned int> retrieved_values;
+  // Values this organism has retrieved so far (bounded, see KnownIDSet.h)
+  KnownIDSet retrieved_values;
   // Highest Cell ID known
   unsigned int max_known;
+  // Cycles saved up while isolated (see CpuBudget::isolated_batch), and over how many updates
+  uint32_t banked_cycles = 0;
+  uint32_t banked_updates = 0;
+  // Tasks solved during update solved_update (bit per task), so each solver
+  // is counted once per task and update
+  uint64_t solved_update = UINT64_MAX;
+  uint64_t solved_tasks = 0;
 
 };
 
@@ -0,0 +1,231 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/Evolve/World_structure.hpp"
+
+class Organism;
+
+/**
+ * A fixed set of worker threads that repeatedly run batches of independent
+ * tasks numbered 0..n-1. The calling thread takes part in every batch, so a
+ * pool for N threads only spawns N-1 workers, and a pool for one thread runs
+ * everything inline.
+ */
+class WorkerPool
+{
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable start_cv;
+  std::condition_variable done_cv;
+  const std::function<void(size_t)> *job = nullptr;
+  size_t job_size = 0;
+  size_t generation = 0;
+  size_t busy = 0;
+  bool stopping = false;
+  std::atomic<size_t> next_task{0};
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Claim and run tasks of the current batch until none are left.
+   */
+  void RunTasks()
+  {
+    for (size_t task = next_task++; task < job_size; task = next_task++)
+    {
+      (*job)(task);
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Body of each worker thread. Sleeps until a new batch is posted.
+   */
+  void WorkerLoop()
+  {
+    size_t seen = 0;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        start_cv.wait(lock, [&]
+                      { return stopping || generation != seen; });
+        if (stopping)
+          return;
+        seen = generation;
+      }
+      RunTasks();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0)
+          done_cv.notify_one();
+      }
+    }
+  }
+
+public:
+  WorkerPool(size_t num_threads)
+  {
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+      workers.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    start_cv.notify_all();
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  size_t GetNumThreads() const { return workers.size() + 1; }
+
+  /**
+   * Input: The number of tasks and the function to run on each task index.
+   *
+   * Output: None
+   *
+   * Purpose: Run every task once across all threads and wait for them to finish.
+   * The function must stay alive until Run returns.
+   */
+  void Run(size_t num_tasks, const std::function<void(size_t)> &fn)
+  {
+    if (workers.empty())
+    {
+      for (size_t task = 0; task < num_tasks; ++task)
+        fn(task);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = &fn;
+      job_size = num_tasks;
+      next_task = 0;
+      busy = workers.size();
+      ++generation;
+    }
+    start_cv.notify_all();
+    RunTasks();
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [&]
+                 { return busy == 0; });
+  }
+};
+
+/**
+ * Everything an organism's CPU writes to shared world state while a tile is
+ * being processed. Each tile gets its own tally so threads never share
+ * counters, and tallies are merged back in tile order afterwards.
+ */
+struct TileTally
+{
+  // Seed for this tile's schedule and sgpl::tlrand on the current update
+  int seed = 1;
+  emp::vector<emp::WorldPosition> reproduce_queue;
+  // Organisms that died in this tile, handed back to the pool after the phase
+  std::vector<emp::Ptr<Organism>> deaths;
+  std::vector<int> solve_counts;
+  std::vector<int> solver_counts;
+  // Message bins hit by sends/retrieves (cell index, or -1 for non-IDs)
+  std::vector<int> send_events;
+  std::vector<int> recv_events;
+  // CPU cycles run by the tile's organisms
+  size_t cycles = 0;
+};
+
+/**
+ * Splits the toroidal cell grid into rectangular tiles and colors them in a
+ * 2x2 checkerboard. Every organism only ever touches its own cell and the 8
+ * cells around it (SendMessage writes the neighbour's inbox and reads its
+ * facing, RotateLeft/RotateRight write its own facing). Tiles are at least two
+ * cells across and each dimension has an even number of tiles, so two tiles of
+ * the same color are always separated by a whole tile, even across the wrap.
+ * Their neighbourhoods never overlap, which lets all tiles of one color run at
+ * the same time. Reproduction is already deferred to ReproduceAllValidOrganisms.
+ */
+struct TilePlan
+{
+  // Cell linear indices (x * height + y) covered by each tile
+  std::vector<emp::vector<size_t>> tile_cells;
+  // Tile that owns each cell linear index
+  std::vector<size_t> tile_of;
+  // Tiles of each of the 4 colors, run one color after another
+  std::vector<std::vector<size_t>> color_tiles;
+
+  /**
+   * Input: Length of one grid dimension and the requested tile side length.
+   *
+   * Output: A tile count that keeps the checkerboard valid across the wrap.
+   *
+   * Purpose: An odd count would put two same-colored tiles next to each other
+   * at the edge of the torus, so round it down to an even one.
+   */
+  static int ValidTileCount(int length, int tile_size)
+  {
+    int count = length / std::max(tile_size, 2);
+    if (count > 1 && count % 2 == 1)
+      --count;
+    return std::max(count, 1);
+  }
+
+  /**
+   * Input: Grid width and height, and the requested tile side length.
+   *
+   * Output: None
+   *
+   * Purpose: Build the tiles and colors for the grid.
+   */
+  void Build(int width, int height, int tile_size)
+  {
+    const int tiles_x = ValidTileCount(width, tile_size);
+    const int tiles_y = ValidTileCount(height, tile_size);
+
+    tile_cells.assign(tiles_x * tiles_y, emp::vector<size_t>());
+    tile_of.assign(width * height, 0);
+    color_tiles.assign(4, std::vector<size_t>());
+
+    for (int x = 0; x < width; ++x)
+    {
+      const int tx = x * tiles_x / width;
+      for (int y = 0; y < height; ++y)
+      {
+        const int ty = y * tiles_y / height;
+        const size_t tile = tx * tiles_y + ty;
+        const size_t idx = x * height + y;
+        tile_cells[tile].push_back(idx);
+        tile_of[idx] = tile;
+      }
+    }
+
+    for (int tx = 0; tx < tiles_x; ++tx)
+    {
+      for (int ty = 0; ty < tiles_y; ++ty)
+      {
+        color_tiles[(tx % 2) * 2 + (ty % 2)].push_back(tx * tiles_y + ty);
+      }
+    }
+  }
+
+  size_t GetNumTiles() const { return tile_cells.size(); }
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef PIXELGRID_H
+#define PIXELGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * An RGBA image of the world grid, one cell_size x cell_size square per cell,
+ * drawn in C++ so the web view can hand a whole frame to the canvas with a
+ * single putImageData call instead of a Rect and a Line call per cell.
+ *
+ * Pixels are packed as 0xAABBGGRR, which is RGBA byte order in memory on
+ * little-endian targets like WebAssembly. Cell borders (the top and left edge
+ * of each square) are drawn once up front and cell colors only fill the
+ * inside of each square. Facing arrows are precomputed per direction as lists
+ * of pixel offsets and stamped on top.
+ *
+ * Each cell remembers the color and facing it was last drawn with, and only
+ * cells whose look changed are drawn again. The changed cells are tracked as
+ * a bounding box, so only that part of the image needs to reach the canvas.
+ */
+class PixelGrid
+{
+  size_t cols;
+  size_t rows;
+  size_t cell_size;
+  size_t width;
+  // Offset of a cell's first inside pixel from the corner of its square
+  size_t inset;
+  std::vector<uint32_t> pixels;
+  // Pixels of the arrow in each of the 8 directions, relative to the cell's corner
+  std::vector<size_t> arrows[8];
+  // What each cell (x * rows + y) was last drawn with; a facing of -1 is no arrow
+  std::vector<uint32_t> cell_colors;
+  std::vector<int8_t> cell_facings;
+  // Cells changed since the last ClearDirty, as columns [x0, x1) and rows [y0, y1)
+  size_t dirty_x0, dirty_x1, dirty_y0, dirty_y1;
+
+public:
+  static constexpr uint32_t BLACK = 0xff000000;
+  static constexpr uint32_t WHITE = 0xffffffff;
+
+  /**
+   * Input: Red, green and blue from 0 to 255
+   *
+   * Output: A packed, opaque pixel
+   *
+   * Purpose: Build a pixel color.
+   */
+  static uint32_t RGB(uint32_t r, uint32_t g, uint32_t b)
+  {
+    return 0xff000000 | (b << 16) | (g << 8) | r;
+  }
+
+  /**
+   * Input: Hue in degrees, saturation and value from 0 to 1
+   *
+   * Output: A packed, opaque pixel
+   *
+   * Purpose: The same color emp::ColorHSV names, without building a string.
+   */
+  static uint32_t HSV(double h, double s, double v)
+  {
+    h = std::fmod(h, 360.0);
+    if (h < 0)
+      h += 360.0;
+    const double c = v * s;
+    const double x = c * (1 - std::fabs(std::fmod(h / 60.0, 2.0) - 1));
+    const double m = v - c;
+    double r = 0, g = 0, b = 0;
+    switch (static_cast<int>(h / 60.0))
+    {
+    case 0: r = c; g = x; break;
+    case 1: r = x; g = c; break;
+    case 2: g = c; b = x; break;
+    case 3: g = x; b = c; break;
+    case 4: r = x; b = c; break;
+    default: r = c; b = x; break;
+    }
+    auto channel = [m](double value)
+    { return static_cast<uint32_t>(std::lround((value + m) * 255)); };
+    return RGB(channel(r), channel(g), channel(b));
+  }
+
+  /**
+   * Input: The grid's columns and rows, and the side of a cell in pixels
+   *
+   * Output: None
+   *
+   * Purpose: Allocate the image, draw the cell borders and build the arrow
+   * sprites. Cells under 3 pixels get no borders and cells under 5 no arrows,
+   * since neither would leave room to see the color.
+   */
+  PixelGrid(size_t _cols, size_t _rows, size_t _cell_size)
+      : cols(_cols), rows(_rows), cell_size(std::max<size_t>(_cell_size, 1)),
+        width(cols * cell_size), inset(cell_size >= 3 ? 1 : 0),
+        pixels(width * rows * cell_size, WHITE), cell_colors(cols * rows, WHITE), cell_facings(cols * rows, -1),
+        // The canvas starts out blank, so the first frame sends everything
+        dirty_x0(0), dirty_x1(cols), dirty_y0(0), dirty_y1(rows)
+  {
+    if (inset)
+    {
+      for (size_t py = 0; py < GetHeight(); ++py)
+      {
+        for (size_t px = 0; px < width; ++px)
+        {
+          if (px % cell_size == 0 || py % cell_size == 0)
+            pixels[py * width + px] = BLACK;
+        }
+      }
+    }
+    if (cell_size >= 5)
+      BuildArrows();
+  }
+
+  size_t GetWidth() const { return width; }
+  size_t GetHeight() const { return rows * cell_size; }
+  const uint32_t *GetPixels() const { return pixels.data(); }
+  size_t GetByteSize() const { return pixels.size() * sizeof(uint32_t); }
+
+  // The changed part of the image, in pixels
+  bool IsDirty() const { return dirty_x0 < dirty_x1; }
+  size_t GetDirtyLeft() const { return dirty_x0 * cell_size; }
+  size_t GetDirtyTop() const { return dirty_y0 * cell_size; }
+  size_t GetDirtyWidth() const { return (dirty_x1 - dirty_x0) * cell_size; }
+  size_t GetDirtyHeight() const { return (dirty_y1 - dirty_y0) * cell_size; }
+
+  // Call once the changed part has been copied to the canvas
+  void ClearDirty()
+  {
+    dirty_x0 = dirty_y0 = SIZE_MAX;
+    dirty_x1 = dirty_y1 = 0;
+  }
+
+  /**
+   * Input: A cell's column and row, its color and the direction it faces
+   * (0-N to 7-NW, or -1 for no arrow)
+   *
+   * Output: Whether the cell had to be drawn
+   *
+   * Purpose: Draw a cell if it looks different from the last time it was drawn.
+   */
+  bool DrawCell(size_t x, size_t y, uint32_t color, int dir)
+  {
+    const size_t idx = x * rows + y;
+    if (cell_colors[idx] == color && cell_facings[idx] == dir)
+      return false;
+    cell_colors[idx] = color;
+    cell_facings[idx] = static_cast<int8_t>(dir);
+    FillCell(x, y, color);
+    if (dir >= 0)
+      DrawArrow(x, y, dir);
+    dirty_x0 = std::min(dirty_x0, x);
+    dirty_x1 = std::max(dirty_x1, x + 1);
+    dirty_y0 = std::min(dirty_y0, y);
+    dirty_y1 = std::max(dirty_y1, y + 1);
+    return true;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: For each direction (0-N to 7-NW), find the pixels within one
+   * pixel of the segment from the cell's center 0.4 cells along that
+   * direction, which is the 2 pixel wide line the canvas used to draw.
+   */
+  void BuildArrows()
+  {
+    static constexpr double dir_dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static constexpr double dir_dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    const double center = cell_size / 2.0;
+    const double step = 0.4 * cell_size;
+    for (int dir = 0; dir < 8; ++dir)
+    {
+      const double ex = dir_dx[dir] * step;
+      const double ey = dir_dy[dir] * step;
+      const double length_sq = ex * ex + ey * ey;
+      for (size_t y = inset; y < cell_size; ++y)
+      {
+        for (size_t x = inset; x < cell_size; ++x)
+        {
+          const double px = x + 0.5 - center;
+          const double py = y + 0.5 - center;
+          const double t = std::clamp((px * ex + py * ey) / length_sq, 0.0, 1.0);
+          const double dx = px - t * ex;
+          const double dy = py - t * ey;
+          if (dx * dx + dy * dy <= 1.0)
+            arrows[dir].push_back(y * width + x);
+        }
+      }
+    }
+  }
+
+  /**
+   * Input: A cell's column and row, and its color
+   *
+   * Output: None
+   *
+   * Purpose: Fill the inside of the cell's square.
+   */
+  void FillCell(size_t x, size_t y, uint32_t color)
+  {
+    uint32_t *row = &pixels[(y * cell_size + inset) * width + x * cell_size + inset];
+    const size_t side = cell_size - inset;
+    for (size_t i = 0; i < side; ++i, row += width)
+      std::fill(row, row + side, color);
+  }
+
+  /**
+   * Input: A cell's column and row, and the direction it faces (0-N to 7-NW)
+   *
+   * Output: None
+   *
+   * Purpose: Draw the facing arrow on the cell, after its fill.
+   */
+  void DrawArrow(size_t x, size_t y, int dir)
+  {
+    uint32_t *corner = &pixels[y * cell_size * width + x * cell_size];
+    for (size_t offset : arrows[dir & 7])
+      corner[offset] = BLACK;
+  }
+};
+
+#endif
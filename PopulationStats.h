@@ -0,0 +1,284 @@
+#ifndef POPULATIONSTATS_H
+#define POPULATIONSTATS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Min and max of a value over the cells of the world, as a bottom-up segment
+ * tree with one leaf per cell. Setting a leaf is O(1): it only marks the leaf
+ * dirty. The inner nodes are repaired when the min or max is read, walking up
+ * from each dirty leaf, or with one bottom-up pass over the whole tree once
+ * enough leaves are dirty that the pass is cheaper. A run that never reads
+ * the range never pays for the inner nodes.
+ */
+template <typename T>
+class MinMaxTree
+{
+  static constexpr T NONE_MIN = std::numeric_limits<T>::max();
+  static constexpr T NONE_MAX = std::numeric_limits<T>::lowest();
+
+  size_t base = 1;
+  size_t depth = 0;
+  std::vector<T> mins;
+  std::vector<T> maxs;
+  std::vector<uint32_t> dirty;
+  std::vector<uint8_t> is_dirty;
+
+  void Pull(size_t node)
+  {
+    mins[node] = std::min(mins[2 * node], mins[2 * node + 1]);
+    maxs[node] = std::max(maxs[2 * node], maxs[2 * node + 1]);
+  }
+
+public:
+  void Resize(size_t num_leaves)
+  {
+    base = 1;
+    depth = 0;
+    while (base < num_leaves)
+    {
+      base <<= 1;
+      ++depth;
+    }
+    mins.assign(2 * base, NONE_MIN);
+    maxs.assign(2 * base, NONE_MAX);
+    is_dirty.assign(base, 0);
+    dirty.clear();
+  }
+
+  void Set(size_t leaf, T value)
+  {
+    mins[base + leaf] = value;
+    maxs[base + leaf] = value;
+    if (!is_dirty[leaf])
+    {
+      is_dirty[leaf] = 1;
+      dirty.push_back(static_cast<uint32_t>(leaf));
+    }
+  }
+
+  // Leave a leaf out of the range
+  void Clear(size_t leaf)
+  {
+    Set(leaf, NONE_MIN);
+    maxs[base + leaf] = NONE_MAX;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether the whole tree was rebuilt
+   *
+   * Purpose: Bring the inner nodes up to date with the leaves.
+   */
+  bool Repair()
+  {
+    if (dirty.empty())
+      return false;
+    const bool rebuild = dirty.size() * depth >= base;
+    if (rebuild)
+    {
+      for (size_t node = base - 1; node > 0; --node)
+        Pull(node);
+    }
+    else
+    {
+      for (uint32_t leaf : dirty)
+      {
+        for (size_t node = (base + leaf) >> 1; node > 0; node >>= 1)
+          Pull(node);
+      }
+    }
+    for (uint32_t leaf : dirty)
+      is_dirty[leaf] = 0;
+    dirty.clear();
+    return rebuild;
+  }
+
+  // Whether a leaf is set, and its value
+  bool Has(size_t leaf) const { return mins[base + leaf] <= maxs[base + leaf]; }
+  T Get(size_t leaf) const { return mins[base + leaf]; }
+
+  // The range of the set leaves; call Repair first. Empty trees give NONE_MIN/NONE_MAX
+  T GetMin() const { return mins[1]; }
+  T GetMax() const { return maxs[1]; }
+};
+
+/**
+ * Point statistics of the live organisms and the range of cell IDs they
+ * occupy, kept up to date by OrgWorld as organisms are placed, change points
+ * and die. Count, mean and variance come from running sums, and min and max
+ * from MinMaxTrees, so reading them doesn't scan the population.
+ *
+ * Points change for most organisms every update, so a change only stores the
+ * new value and marks the cell. The marked cells are folded into the sums and
+ * the tree when the stats are next read, which costs at most what the changes
+ * would have cost eagerly, and nothing for runs that never read them. The
+ * sums are recomputed from scratch whenever the tree is rebuilt in full, so
+ * rounding errors don't build up over a long run.
+ */
+class PopulationStats
+{
+  std::vector<double> points;
+  std::vector<uint8_t> present;
+  size_t count = 0;
+  // Cells whose organism or points changed since the last read, and what
+  // they are folded into when read. The points tree holds the values the sums
+  // were last brought up to date with
+  mutable std::vector<uint32_t> changed;
+  mutable std::vector<uint8_t> is_changed;
+  mutable double sum = 0;
+  mutable double sum_sq = 0;
+  mutable MinMaxTree<double> point_range;
+  mutable MinMaxTree<unsigned int> id_range;
+
+  void MarkChanged(size_t cell)
+  {
+    if (!is_changed[cell])
+    {
+      is_changed[cell] = 1;
+      changed.push_back(static_cast<uint32_t>(cell));
+    }
+  }
+
+  void Flush() const
+  {
+    for (uint32_t cell : changed)
+    {
+      if (point_range.Has(cell))
+      {
+        const double old = point_range.Get(cell);
+        sum -= old;
+        sum_sq -= old * old;
+      }
+      if (present[cell])
+      {
+        sum += points[cell];
+        sum_sq += points[cell] * points[cell];
+        point_range.Set(cell, points[cell]);
+      }
+      else
+      {
+        point_range.Clear(cell);
+      }
+      is_changed[cell] = 0;
+    }
+    changed.clear();
+    if (point_range.Repair())
+      Resync();
+  }
+
+  void Resync() const
+  {
+    sum = 0;
+    sum_sq = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (present[i])
+      {
+        sum += points[i];
+        sum_sq += points[i] * points[i];
+      }
+    }
+  }
+
+public:
+  void Resize(size_t num_cells)
+  {
+    points.assign(num_cells, 0);
+    present.assign(num_cells, 0);
+    count = 0;
+    changed.clear();
+    is_changed.assign(num_cells, 0);
+    sum = 0;
+    sum_sq = 0;
+    point_range.Resize(num_cells);
+    id_range.Resize(num_cells);
+  }
+
+  /**
+   * Input: A cell, the points of the organism just placed there and the cell's ID
+   *
+   * Output: None
+   *
+   * Purpose: Count a new organism, replacing any organism that was in the cell.
+   */
+  void Add(size_t cell, double value, unsigned int id)
+  {
+    if (!present[cell])
+    {
+      present[cell] = 1;
+      ++count;
+      id_range.Set(cell, id);
+    }
+    points[cell] = value;
+    MarkChanged(cell);
+  }
+
+  // Record that the organism in a cell now has `value` points
+  void SetPoints(size_t cell, double value)
+  {
+    if (points[cell] == value)
+      return;
+    points[cell] = value;
+    MarkChanged(cell);
+  }
+
+  // Forget the organism in a cell, if there is one
+  void Remove(size_t cell)
+  {
+    if (!present[cell])
+      return;
+    present[cell] = 0;
+    --count;
+    id_range.Clear(cell);
+    MarkChanged(cell);
+  }
+
+  size_t GetCount() const { return count; }
+
+  double GetMean() const
+  {
+    Flush();
+    return count ? sum / count : 0.0;
+  }
+
+  double GetVariance() const
+  {
+    Flush();
+    if (!count)
+      return 0.0;
+    const double mean = sum / count;
+    return sum_sq / count - mean * mean;
+  }
+
+  // Min and max points, 0 when the world is empty
+  double GetMinPoints() const
+  {
+    Flush();
+    return count ? point_range.GetMin() : 0.0;
+  }
+  double GetMaxPoints() const
+  {
+    Flush();
+    return count ? point_range.GetMax() : 0.0;
+  }
+
+  // Lowest and highest ID of an occupied cell, 0 when the world is empty
+  unsigned int GetMinID() const
+  {
+    id_range.Repair();
+    return count ? id_range.GetMin() : 0;
+  }
+  unsigned int GetMaxID() const
+  {
+    id_range.Repair();
+    return count ? id_range.GetMax() : 0;
+  }
+};
+
+#endif
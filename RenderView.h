@@ -0,0 +1,34 @@
+#ifndef RENDERVIEW_H
+#define RENDERVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A read-only view of what a renderer needs from the world, as parallel
+ * arrays indexed by cell linear index (x * height + y). OrgWorld::FillRenderView
+ * fills it in one pass over the live organisms, reading only these fields, so
+ * drawing a frame never copies an Organism. The arrays keep their storage
+ * from one fill to the next.
+ *
+ * The organism arrays only hold meaningful values at the indices in `live`;
+ * entries of empty cells are left over from earlier fills.
+ */
+struct RenderView
+{
+  size_t num_cells = 0;
+  // Linear indices of the occupied cells, in index order
+  std::vector<uint32_t> live;
+
+  // Cell fields, pointing into the world's CellGrid (valid while the world is)
+  const unsigned int *cell_ids = nullptr;
+  const uint8_t *facings = nullptr;
+
+  // Organism fields
+  std::vector<uint32_t> best_task;
+  std::vector<unsigned int> message;
+  std::vector<double> points;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef RUNCONTROL_H
+#define RUNCONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include "ConfigSetup.h"
+#include "World.h"
+
+/**
+ * Watches a native run between updates: prints progress and decides when the
+ * run should stop early, because the population died out or went quiet, a task
+ * is solved often enough, the wall-clock limit passed or the user pressed Ctrl-C.
+ */
+class RunController
+{
+  using clock = std::chrono::steady_clock;
+
+  static inline std::atomic<bool> interrupted{false};
+
+  const MyConfigType &config;
+  std::string label;
+  std::ostream &log;
+  clock::time_point start;
+  clock::time_point last_report;
+  size_t last_report_update = 0;
+  std::string stop_reason;
+
+  static void OnInterrupt(int)
+  {
+    interrupted = true;
+    // A second Ctrl-C kills the run the usual way
+    std::signal(SIGINT, SIG_DFL);
+  }
+
+public:
+  /**
+   * Input: The run's config, a label for its log lines and the log stream
+   *
+   * Output: None
+   *
+   * Purpose: Start the run's clocks.
+   */
+  RunController(const MyConfigType &cfg, const std::string &_label, std::ostream &_log)
+      : config(cfg), label(_label), log(_log), start(clock::now()), last_report(start)
+  {
+    ;
+  }
+
+  // Make Ctrl-C stop every run after its current update instead of killing the process
+  static void InstallInterruptHandler() { std::signal(SIGINT, OnInterrupt); }
+  static bool Interrupted() { return interrupted; }
+
+  const std::string &GetStopReason() const { return stop_reason; }
+  double GetElapsedSeconds() const { return std::chrono::duration<double>(clock::now() - start).count(); }
+
+  /**
+   * Input: The world, after an update
+   *
+   * Output: Whether the run should stop; GetStopReason says why
+   *
+   * Purpose: Report progress when it is due and check the stop conditions.
+   */
+  bool ShouldStop(OrgWorld &world)
+  {
+    const clock::time_point now = clock::now();
+    const double since_report = std::chrono::duration<double>(now - last_report).count();
+    if (config.PROGRESS_INTERVAL() > 0 && since_report >= config.PROGRESS_INTERVAL())
+    {
+      log << label << "update " << world.GetUpdate() << "/" << config.UPDATE_NUM()
+          << ", " << std::fixed << std::setprecision(1)
+          << (world.GetUpdate() - last_report_update) / since_report << " updates/sec, "
+          << world.GetNumOrgs() << " organisms" << std::defaultfloat << std::endl;
+      last_report = now;
+      last_report_update = world.GetUpdate();
+    }
+
+    if (interrupted)
+      stop_reason = "interrupted";
+    else if (config.STOP_ON_EXTINCTION() && world.GetNumOrgs() == 0)
+      stop_reason = "population extinct";
+    else if (config.QUIESCENT_WINDOW() > 0 && world.GetNumOrgs() > 0 &&
+             world.GetQuietUpdates() >= (size_t)config.QUIESCENT_WINDOW())
+      stop_reason = "no births, deaths or messages for " + std::to_string(world.GetQuietUpdates()) + " updates";
+    else if (config.MAX_WALL_SECONDS() > 0 && GetElapsedSeconds() >= config.MAX_WALL_SECONDS())
+      stop_reason = "wall-clock limit reached";
+    else if (config.STOP_SOLVE_RATE() > 0 && world.GetNumOrgs() > 0)
+    {
+      const size_t task = config.STOP_SOLVE_TASK() < 0 ? world.GetNumTasks() - 1 : config.STOP_SOLVE_TASK();
+      const double rate = static_cast<double>(world.GetSolverCount(task)) / world.GetNumOrgs();
+      if (rate >= config.STOP_SOLVE_RATE())
+        stop_reason = "solve rate of task " + std::to_string(task) + " reached";
+    }
+    return !stop_reason.empty();
+  }
+};
+
+#endif
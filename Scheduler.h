@@ -0,0 +1,108 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <iostream>
+#include <numeric>
+#include <string>
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+#include "emp/math/random_utils.hpp"
+#include "Cell.h"
+
+// Orders in which the serial update runs organisms
+enum class SchedulePolicy
+{
+  LEGACY,      // a fresh random permutation of every cell, as originally
+  RANDOM,      // the live organisms, shuffled
+  SEQUENTIAL,  // the live organisms by cell index
+  CHECKERBOARD // live organisms on even (x + y) cells, then odd, each shuffled
+};
+
+/**
+ * Builds the order of each serial update, in storage that is kept between
+ * updates, so an update allocates nothing. Except for LEGACY, the order is a
+ * list of just the occupied cells, gathered from the grid's occupancy bits,
+ * so its cost follows the number of organisms rather than the grid area.
+ */
+class UpdateScheduler
+{
+  SchedulePolicy policy = SchedulePolicy::LEGACY;
+  emp::vector<size_t> order;
+  emp::vector<size_t> odd_cells;
+
+public:
+  /**
+   * Input: The SCHEDULE setting and the number of cells
+   *
+   * Output: None
+   *
+   * Purpose: Pick the policy. Unknown names fall back to legacy with a warning.
+   */
+  void Setup(const std::string &name, size_t num_cells)
+  {
+    if (name == "random")
+      policy = SchedulePolicy::RANDOM;
+    else if (name == "sequential")
+      policy = SchedulePolicy::SEQUENTIAL;
+    else if (name == "checkerboard")
+      policy = SchedulePolicy::CHECKERBOARD;
+    else
+    {
+      if (name != "legacy")
+        std::cerr << "Unknown SCHEDULE " << name << ", using legacy" << std::endl;
+      policy = SchedulePolicy::LEGACY;
+    }
+    order.reserve(num_cells);
+    odd_cells.reserve(num_cells);
+  }
+
+  SchedulePolicy GetPolicy() const { return policy; }
+
+  /**
+   * Input: The cell grid and the world's random number generator
+   *
+   * Output: The cells to run this update, in order. Legacy orders include
+   * empty cells, which the caller skips.
+   *
+   * Purpose: Build the order of one update.
+   */
+  const emp::vector<size_t> &Build(const CellGrid &grid, emp::Random &random)
+  {
+    switch (policy)
+    {
+    case SchedulePolicy::LEGACY:
+      // What emp::GetPermutation does, in the kept storage
+      order.resize(grid.GetSize());
+      std::iota(order.begin(), order.end(), 0);
+      emp::Shuffle(random, order);
+      break;
+    case SchedulePolicy::RANDOM:
+    case SchedulePolicy::SEQUENTIAL:
+      order.clear();
+      grid.ForEachOccupied([this](size_t idx)
+                           { order.push_back(idx); });
+      if (policy == SchedulePolicy::RANDOM)
+        emp::Shuffle(random, order);
+      break;
+    case SchedulePolicy::CHECKERBOARD:
+    {
+      const size_t height = grid.GetHeight();
+      order.clear();
+      odd_cells.clear();
+      grid.ForEachOccupied([&](size_t idx)
+                           {
+        if ((idx / height + idx % height) & 1)
+          odd_cells.push_back(idx);
+        else
+          order.push_back(idx); });
+      emp::Shuffle(random, order);
+      emp::Shuffle(random, odd_cells);
+      order.insert(order.end(), odd_cells.begin(), odd_cells.end());
+      break;
+    }
+    }
+    return order;
+  }
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * Runs batches of simulation steps away from the render loop and hands back a
+ * snapshot after each batch. The renderer asks for a batch once a frame and
+ * takes whichever snapshot is ready, so a slow batch delays the picture rather
+ * than the page. At most one batch is in flight, and snapshot buffers are
+ * swapped rather than copied, so nothing is allocated per batch once they
+ * have all grown to size.
+ *
+ * Without threads (e.g. a web build without -pthread) the same interface runs
+ * each batch inline when it is requested.
+ */
+template <typename SNAPSHOT>
+class SimThread
+{
+public:
+  using step_fun_t = std::function<void()>;
+  using snapshot_fun_t = std::function<void(SNAPSHOT &)>;
+
+private:
+  step_fun_t step;
+  snapshot_fun_t take_snapshot;
+  bool threaded;
+
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable wake;
+  // Steps of the batch in flight (0 when idle)
+  size_t requested = 0;
+  bool fresh = false;
+  bool quit = false;
+  SNAPSHOT published;
+  // Only touched by the simulation side
+  SNAPSHOT back;
+
+  // Run one batch and publish its snapshot
+  void RunBatch(size_t steps)
+  {
+    for (size_t i = 0; i < steps; ++i)
+      step();
+    take_snapshot(back);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(published, back);
+    fresh = true;
+    requested = 0;
+  }
+
+  void Loop()
+  {
+    for (;;)
+    {
+      size_t steps;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this]()
+                  { return quit || requested; });
+        if (quit)
+          return;
+        steps = requested;
+      }
+      RunBatch(steps);
+      wake.notify_all();
+    }
+  }
+
+public:
+  /**
+   * Input: A function running one step, a function filling in a snapshot and
+   * whether to use a thread
+   *
+   * Output: None
+   *
+   * Purpose: Start the simulation thread, idle until the first request.
+   */
+  SimThread(step_fun_t _step, snapshot_fun_t _take_snapshot, bool _threaded)
+      : step(std::move(_step)), take_snapshot(std::move(_take_snapshot)), threaded(_threaded)
+  {
+    if (threaded)
+      thread = std::thread([this]()
+                           { Loop(); });
+  }
+
+  ~SimThread()
+  {
+    if (!threaded)
+      return;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+    }
+    wake.notify_all();
+    thread.join();
+  }
+
+  bool IsThreaded() const { return threaded; }
+
+  /**
+   * Input: The number of steps to run
+   *
+   * Output: None
+   *
+   * Purpose: Start a batch, unless one is still running.
+   */
+  void Request(size_t steps)
+  {
+    if (!steps)
+      return;
+    if (!threaded)
+    {
+      RunBatch(steps);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (requested)
+        return;
+      requested = steps;
+    }
+    wake.notify_all();
+  }
+
+  /**
+   * Input: Where to put the snapshot, and whether to wait for the batch in flight
+   *
+   * Output: Whether there was a new snapshot
+   *
+   * Purpose: Take the latest snapshot. The caller's old snapshot becomes the
+   * buffer the next one is built in.
+   */
+  bool TakeSnapshot(SNAPSHOT &out, bool wait)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (wait)
+      wake.wait(lock, [this]()
+                { return !requested || quit; });
+    if (!fresh)
+      return false;
+    std::swap(out, published);
+    fresh = false;
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef SPARSEDATAFILE_H
+#define SPARSEDATAFILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Binary, sparse alternative to emp::DataFile for wide files that are mostly
+ * zeros. Every row only stores its non-zero columns, so the size of a row and
+ * the time to write it follow the activity in the world, not its size.
+ * sparse_to_csv turns a file back into the CSV emp::DataFile would have written.
+ *
+ * File layout (all integers are LEB128 varints unless noted):
+ *   "ORGSPARS" magic, uint32 version, number of columns, then each column name
+ *   as a length followed by its bytes. The "update" column is implicit.
+ *   Then a sequence of records, each one of:
+ *     byte SPARSE_ROW, update delta from the previous row, number of non-zero
+ *     entries, then per entry the gap to the previous non-zero column and the
+ *     zigzag-encoded value.
+ *     byte SPARSE_EMPTY_RUN, update delta to the first row of the run, number
+ *     of rows and the update step between them. Stands for that many rows of
+ *     zeros (version 2 and later).
+ */
+enum SparseRecordType : uint8_t
+{
+  SPARSE_ROW = 1,
+  SPARSE_EMPTY_RUN = 2
+};
+
+// Format version SparseDataFile writes; SparseDataReader reads this and older ones
+constexpr uint32_t SPARSE_FILE_VERSION = 2;
+
+class SparseDataFile
+{
+public:
+  using fill_fun_t = std::function<void(SparseDataFile &)>;
+
+private:
+  std::ofstream out;
+  fill_fun_t fill;
+  size_t repeat = 1;
+  size_t last_update = 0;
+  std::vector<std::pair<size_t, int64_t>> entries;
+  std::vector<uint8_t> buffer;
+
+  void PutVarint(uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      buffer.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+  }
+
+  void PutString(const std::string &str)
+  {
+    PutVarint(str.size());
+    buffer.insert(buffer.end(), str.begin(), str.end());
+  }
+
+  void WriteBuffer()
+  {
+    out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    buffer.clear();
+  }
+
+public:
+  SparseDataFile(const std::string &filename, const std::vector<std::string> &columns, fill_fun_t _fill,
+                 bool append = false)
+      : out(filename, std::ios::binary | (append ? std::ios::app : std::ios::trunc)), fill(std::move(_fill))
+  {
+    // Appending continues a file whose header was already written
+    if (append)
+    {
+      out.seekp(0, std::ios::end);
+      return;
+    }
+    out.write("ORGSPARS", 8);
+    out.write(reinterpret_cast<const char *>(&SPARSE_FILE_VERSION), sizeof(SPARSE_FILE_VERSION));
+    PutVarint(columns.size());
+    for (const std::string &name : columns)
+      PutString(name);
+    WriteBuffer();
+  }
+
+  ~SparseDataFile() { out.flush(); }
+
+  // Used by checkpoints to cut the file back to a known row and continue from it
+  size_t GetLastUpdate() const { return last_update; }
+  void SetLastUpdate(size_t update) { last_update = update; }
+  uint64_t FlushAndGetOffset()
+  {
+    out.flush();
+    return static_cast<uint64_t>(out.tellp());
+  }
+
+  SparseDataFile &SetTimingRepeat(size_t step)
+  {
+    repeat = std::max<size_t>(step, 1);
+    return *this;
+  }
+
+  /**
+   * Input: A column index and its value for the row being written.
+   *
+   * Output: None
+   *
+   * Purpose: Called from the fill function. Zeros may be skipped, columns may
+   * come in any order, and each column should only be given once.
+   */
+  void Put(size_t column, int64_t value)
+  {
+    if (value != 0)
+      entries.emplace_back(column, value);
+  }
+
+  /**
+   * Input: The current update.
+   *
+   * Output: None
+   *
+   * Purpose: Write a row if this update is on the file's timing.
+   */
+  void Update(size_t update)
+  {
+    if (update % repeat != 0)
+      return;
+
+    entries.clear();
+    fill(*this);
+    std::sort(entries.begin(), entries.end());
+
+    buffer.push_back(SPARSE_ROW);
+    PutVarint(update - last_update);
+    PutVarint(entries.size());
+    size_t next_column = 0;
+    for (const auto &[column, value] : entries)
+    {
+      PutVarint(column - next_column);
+      PutVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+      next_column = column + 1;
+    }
+    WriteBuffer();
+    last_update = update;
+  }
+
+  /**
+   * Input: The first update to skip and the update to skip to.
+   *
+   * Output: None
+   *
+   * Purpose: Record every row on the file's timing in [from, to) as all zeros
+   * without filling them, as a single run record.
+   */
+  void PutEmptyRows(size_t from, size_t to)
+  {
+    const size_t first = (from + repeat - 1) / repeat * repeat;
+    if (first >= to)
+      return;
+    const size_t count = (to - first + repeat - 1) / repeat;
+
+    buffer.push_back(SPARSE_EMPTY_RUN);
+    PutVarint(first - last_update);
+    PutVarint(count);
+    PutVarint(repeat);
+    WriteBuffer();
+    last_update = first + (count - 1) * repeat;
+  }
+};
+
+/**
+ * Reads a file written by SparseDataFile back one row at a time.
+ */
+class SparseDataReader
+{
+  std::ifstream in;
+  std::vector<std::string> columns;
+  size_t update = 0;
+  bool valid = false;
+  // Rows of an empty run still to be returned, and the update step between them
+  uint64_t pending_empty = 0;
+  uint64_t empty_step = 0;
+
+  bool GetVarint(uint64_t &value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      const int byte = in.get();
+      if (byte == EOF)
+        return false;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+public:
+  SparseDataReader(const std::string &filename) : in(filename, std::ios::binary)
+  {
+    char magic[8];
+    uint32_t version = 0;
+    in.read(magic, 8);
+    in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    if (!in || std::string(magic, 8) != "ORGSPARS" || version < 1 || version > SPARSE_FILE_VERSION)
+      return;
+
+    uint64_t num_columns = 0;
+    if (!GetVarint(num_columns))
+      return;
+    columns.resize(num_columns);
+    for (std::string &name : columns)
+    {
+      uint64_t length = 0;
+      if (!GetVarint(length))
+        return;
+      name.resize(length);
+      in.read(&name[0], length);
+    }
+    valid = static_cast<bool>(in);
+  }
+
+  bool IsValid() const { return valid; }
+  const std::vector<std::string> &GetColumns() const { return columns; }
+
+  /**
+   * Input: A vector to hold one value per column.
+   *
+   * Output: The update of the row, or false at the end of the file.
+   *
+   * Purpose: Decode the next row, filling in the columns that were skipped as zeros.
+   * Empty runs are expanded into one row per update they cover.
+   */
+  bool NextRow(size_t &row_update, std::vector<int64_t> &values)
+  {
+    if (pending_empty)
+    {
+      --pending_empty;
+      update += empty_step;
+      values.assign(columns.size(), 0);
+      row_update = update;
+      return true;
+    }
+
+    const int type = in.get();
+    if (type == SPARSE_EMPTY_RUN)
+    {
+      uint64_t delta = 0, count = 0;
+      if (!GetVarint(delta) || !GetVarint(count) || !GetVarint(empty_step) || count == 0)
+        return false;
+      update += delta;
+      pending_empty = count - 1;
+      values.assign(columns.size(), 0);
+      row_update = update;
+      return true;
+    }
+    if (type != SPARSE_ROW)
+      return false;
+
+    uint64_t delta = 0, count = 0;
+    if (!GetVarint(delta) || !GetVarint(count))
+      return false;
+    update += delta;
+    values.assign(columns.size(), 0);
+    size_t column = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      uint64_t gap = 0, zigzag = 0;
+      if (!GetVarint(gap) || !GetVarint(zigzag))
+        return false;
+      column += gap;
+      if (column >= values.size())
+        return false;
+      values[column] = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+      ++column;
+    }
+    row_update = update;
+    return true;
+  }
+};
+
+#endif
@@ -9,7 +9,34 @@
 #include "World.h"
 
 /**
- * The interface for a task that organisms can complete.
+ * What tasks look at when an organism sends a message, worked out once per
+ * send and shared by every task that is checked.
+ */
+struct TaskFacts {
+  const OrgState &state;
+  Cell cell;
+  Cell target;
+  unsigned int cell_id;
+  // The faced cell holds an organism
+  bool target_has_org;
+  // ... and that organism faces back
+  bool faced_by_target;
+  // The message is the organism's own cell ID or one it has retrieved
+  bool message_is_known_id;
+
+  TaskFacts(const OrgState &_state)
+      : state(_state), cell(_state.cell), target(cell.GetFacingCell()), cell_id(cell.GetID()),
+        target_has_org(target.GetHasOrg()),
+        faced_by_target(target_has_org && target.GetFacingCell() == cell),
+        message_is_known_id(_state.retrieved_values.Contains(_state.message, _state.message_idx) ||
+                            _state.message == cell_id) {}
+};
+
+/**
+ * The interface for a task that organisms can complete. Each task also has a
+ * static Evaluate(const TaskFacts&) with the same result as CheckOutput, which
+ * a TaskSet (TaskSet.h) calls directly so the active tasks are checked in one
+ * inlined pass.
  */
 class Task {
   public:
@@ -34,9 +61,10 @@ class Task {
 // Task: Nothing. This is just for the purpose of categorizing the organisms
 class Initial : public Task {
   public:
-    double CheckOutput(OrgState &state) override {
+    static double Evaluate(const TaskFacts &facts) {
       return 0.0;
     }
+    double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
 
     std::string name() const override { return "Initial"; }
   };
@@ -45,16 +73,15 @@ class Initial : public Task {
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class TargetAnother : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    if (tar_cell->GetHasOrg()) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (facts.target_has_org) {
       return 1.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Target Another Organism"; }
 };
 
@@ -62,31 +89,31 @@ public:
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class FaceAnother : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    if (tar_cell->GetHasOrg() && tar_cell->GetFacingCell() == cur_cell ) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (facts.faced_by_target) {
       return 10.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Face Another Organism"; }
 };
 
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class PrepMessage : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
+  static double Evaluate(const TaskFacts &facts) {
 
-    if (state.message > 0) {
+    if (facts.state.message > 0) {
       return 1.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Prepare Message"; }
 };
 
@@ -95,21 +122,17 @@ public:
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class PrepHighest : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    unsigned int cell_id  = cur_cell->GetID();
-    unsigned int retrieved = state.retrieved;
+  static double Evaluate(const TaskFacts &facts) {
+    unsigned int max_val = std::max(facts.cell_id, facts.state.retrieved);
 
-    unsigned int max_val = std::max(cell_id, retrieved);
-
-    if (state.message == max_val) {
+    if (facts.state.message == max_val) {
       return 20.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Prepare Highest Value"; }
 };
 
@@ -117,95 +140,77 @@ public:
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class SendHighest : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    unsigned int cell_id  = cur_cell->GetID();
-    unsigned int retrieved = state.retrieved;
-
-    unsigned int max_val = std::max(cell_id, retrieved);
+  static double Evaluate(const TaskFacts &facts) {
+    unsigned int max_val = std::max(facts.cell_id, facts.state.retrieved);
 
-    if (tar_cell->GetHasOrg() && tar_cell->GetFacingCell() == cur_cell && state.message == max_val ) {
+    if (facts.faced_by_target && facts.state.message == max_val ) {
       return 30.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Send Highest"; }
 };
 
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class SendSelf : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    unsigned int cell_id  = cur_cell->GetID();
-
-    if (state.message == cell_id ) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (facts.state.message == facts.cell_id ) {
       return 10.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Send Self ID"; }
 };
 
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class SendID : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    unsigned int cell_id  = cur_cell->GetID();
-
-    if (state.retrieved_values.count(state.message) || state.message == cell_id) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (facts.message_is_known_id) {
       return 20.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Send Any ID"; }
 };
 
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class SendNonID : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-    unsigned int cell_id  = cur_cell->GetID();
-
-    if (!(state.retrieved_values.count(state.message) || state.message == cell_id)) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (!facts.message_is_known_id) {
       return 0.0;
     }
     else {
       return -5.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Send Non ID"; }
 };
 
 // Task: returns the highest value between received cell ID and org's cell's cell ID
 class MaxKnown : public Task {
 public:
-  double CheckOutput(OrgState &state) override {
-
-    Cell* cur_cell = state.cell;
-    Cell* tar_cell = cur_cell->GetFacingCell();
-
-    if (state.max_known && state.message == state.max_known) {
+  static double Evaluate(const TaskFacts &facts) {
+    if (facts.state.max_known && facts.state.message == facts.state.max_known) {
       return 30.0;
     }
     else {
       return 0.0;
     }
   }
+  double CheckOutput(OrgState &state) override { return Evaluate(TaskFacts(state)); }
   std::string name() const override { return "Send Max Known"; }
 };
 
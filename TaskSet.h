@@ -0,0 +1,80 @@
+#ifndef TASKSET_H
+#define TASKSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "Task.h"
+
+/**
+ * The outcome of checking every task of a TaskSet once.
+ */
+struct TaskResult
+{
+  // Sum of the points of every task, which is 0 for unsolved ones
+  double points = 0.0;
+  // Bit i is set when the i-th task of the set gave points
+  uint32_t solved = 0;
+};
+
+/**
+ * The tasks a world checks, fixed at compile time, in the spirit of sgpl's
+ * OpLibraryCoupler. Evaluate works out the shared TaskFacts once and calls
+ * each task's static Evaluate directly, so the whole set is one inlined pass
+ * with no virtual calls. The tasks' indices are their positions in the list,
+ * the same as in the world's Task* vector and its solve monitors.
+ */
+template <typename... TASKS>
+class TaskSet
+{
+  static_assert(sizeof...(TASKS) <= 32, "A TaskSet's solve mask holds at most 32 tasks");
+
+  template <size_t... I>
+  static void EvaluateAll(const TaskFacts &facts, TaskResult &result, std::index_sequence<I...>)
+  {
+    (Add(TASKS::Evaluate(facts), I, result), ...);
+  }
+
+  static void Add(double points, size_t index, TaskResult &result)
+  {
+    if (points != 0.0)
+    {
+      result.points += points;
+      result.solved |= uint32_t(1) << index;
+    }
+  }
+
+public:
+  static constexpr size_t size = sizeof...(TASKS);
+
+  /**
+   * Input: The state of an organism that just sent a message
+   *
+   * Output: The points it earns and which tasks it solved
+   *
+   * Purpose: Check every task of the set in one pass.
+   */
+  static TaskResult Evaluate(const OrgState &state)
+  {
+    const TaskFacts facts(state);
+    TaskResult result;
+    EvaluateAll(facts, result, std::index_sequence_for<TASKS...>{});
+    return result;
+  }
+
+  /**
+   * Input: A function taking a new Task* (the caller owns it)
+   *
+   * Output: None
+   *
+   * Purpose: Create the virtual Task objects of the set, in order, for the
+   * names and solve monitors that data files and the web view use.
+   */
+  template <typename FUN>
+  static void ForEachTask(FUN fn)
+  {
+    (fn(static_cast<Task *>(new TASKS())), ...);
+  }
+};
+
+#endif
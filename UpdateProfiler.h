@@ -0,0 +1,122 @@
+#ifndef UPDATEPROFILER_H
+#define UPDATEPROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// The phases of OrgWorld::Update, in the order they run
+enum UpdatePhase
+{
+  PHASE_SIGNALS = 0, // emp::World::Update, including the OnUpdate monitors
+  PHASE_PROCESS,
+  PHASE_REPRODUCE,
+  NUM_UPDATE_PHASES
+};
+
+/**
+ * Events counted during the updates of one profile sample.
+ */
+struct UpdateCounts
+{
+  size_t org_processes = 0;
+  size_t cpu_cycles = 0;
+  size_t sends = 0;
+  size_t receives = 0;
+  size_t births = 0;
+  // Organisms that ran out of points, and occupants replaced by a birth
+  size_t deaths = 0;
+  // Organisms alive at the start of each update, summed
+  size_t occupancy = 0;
+};
+
+/**
+ * Times the phases of every update and counts what happened in them. Each
+ * sample covers `frequency` updates and becomes one CSV row of the profile
+ * file. The world only holds a profiler when a profile file is configured, so
+ * a run without one pays a null check per phase and per counted event.
+ */
+class UpdateProfiler
+{
+  using clock = std::chrono::steady_clock;
+
+  std::ofstream file;
+  size_t frequency;
+  size_t num_cells;
+
+  clock::time_point lap_start;
+  double phase_seconds[NUM_UPDATE_PHASES] = {};
+  size_t sample_updates = 0;
+
+public:
+  UpdateCounts counts;
+
+  /**
+   * Input: The profile file, the updates per sample and the number of cells in the world
+   *
+   * Output: None
+   *
+   * Purpose: Open the profile file and write its header.
+   */
+  UpdateProfiler(const std::string &filename, size_t _frequency, size_t _num_cells)
+      : file(filename), frequency(_frequency ? _frequency : 1), num_cells(_num_cells)
+  {
+    file << "update,updates,signals_ms,process_ms,reproduce_ms,total_ms,updates_per_sec,"
+            "org_processes,cpu_cycles,ns_per_org_cycle,sends,receives,births,deaths,mean_occupancy\n";
+  }
+
+  // Start timing an update's first phase
+  void StartUpdate(size_t num_orgs)
+  {
+    counts.occupancy += num_orgs;
+    lap_start = clock::now();
+  }
+
+  // End the current phase and start timing the next one
+  void EndPhase(UpdatePhase phase)
+  {
+    const clock::time_point now = clock::now();
+    phase_seconds[phase] += std::chrono::duration<double>(now - lap_start).count();
+    lap_start = now;
+  }
+
+  /**
+   * Input: The world's update counter, after the update
+   *
+   * Output: None
+   *
+   * Purpose: Close an update, and write a row once the sample is complete.
+   */
+  void EndUpdate(size_t update)
+  {
+    if (++sample_updates < frequency)
+      return;
+
+    double total = 0;
+    for (double seconds : phase_seconds)
+      total += seconds;
+    const double cycles = static_cast<double>(counts.cpu_cycles);
+    file << update << "," << sample_updates;
+    for (double seconds : phase_seconds)
+      file << "," << seconds * 1e3;
+    file << "," << total * 1e3
+         << "," << (total > 0 ? sample_updates / total : 0)
+         << "," << counts.org_processes
+         << "," << cycles
+         << "," << (cycles > 0 ? total * 1e9 / cycles : 0)
+         << "," << counts.sends
+         << "," << counts.receives
+         << "," << counts.births
+         << "," << counts.deaths
+         << "," << static_cast<double>(counts.occupancy) / (sample_updates * num_cells)
+         << "\n";
+
+    for (double &seconds : phase_seconds)
+      seconds = 0;
+    counts = UpdateCounts();
+    sample_updates = 0;
+  }
+};
+
+#endif
@@ -5,69 +5,133 @@
 #include "emp/Evolve/World.hpp"
 #include "emp/data/DataFile.hpp"
 #include <vector>
-#include <unordered_map>
+#include <map>
+#include <memory>
+#include <filesystem>
 #include "Org.h"
 #include "Task.h"
+#include "TaskSet.h"
 #include "Cell.h"
 #include "ConfigSetup.h"
+#include "Parallel.h"
+#include "EventTrace.h"
+#include "UpdateProfiler.h"
+#include "Scheduler.h"
+#include "MessageCounts.h"
+#include "SparseDataFile.h"
+#include "Checkpoint.h"
+#include "ObjectPool.h"
+#include "IdIndex.h"
+#include "Inbox.h"
+#include "RenderView.h"
+#include "PopulationStats.h"
 
-class OrgWorld : public emp::World<Organism>
+/**
+ * Owns the streams behind OrgWorld's CSV data files. OrgWorld inherits from it
+ * ahead of emp::World, so the streams outlive the emp::DataFiles that
+ * emp::World deletes on destruction.
+ */
+struct DataStreams
 {
+  std::vector<std::unique_ptr<std::ofstream>> data_streams;
+  std::vector<std::string> data_stream_names;
+};
+
+// The tasks organisms are scored on. The other tasks in Task.h (TargetAnother,
+// FaceAnother, PrepMessage, PrepHighest, SendHighest, SendSelf) can be added here.
+using ActiveTaskSet = TaskSet<Initial, SendNonID, SendID, MaxKnown>;
+
+class OrgWorld : private DataStreams, public emp::World<Organism>
+{
+  // Format of the checkpoints SaveCheckpoint writes; LoadCheckpoint only reads this one
+  static constexpr uint32_t CHECKPOINT_VERSION = 4;
+
+  const MyConfigType &config;
   emp::vector<emp::WorldPosition> reproduce_queue;
   std::vector<Task *> tasks;
   std::vector<emp::Ptr<emp::DataMonitor<int>>> solve_monitors;
   std::vector<int> solve_counts;
+  // Organisms that solved each task during the latest update, each counted once
+  std::vector<int> solver_counts;
 
   std::vector<unsigned int> all_cell_ids;
-  std::unordered_map<unsigned int, int> id_to_idx;
+  // Cell ID -> cell index, built once the IDs are set
+  IdIndex id_index;
 
-  std::vector<emp::Ptr<emp::DataMonitor<int>>> send_monitors;
-  std::vector<emp::Ptr<emp::DataMonitor<int>>> recv_monitors;
-  std::vector<int> send_counts;
-  std::vector<int> recv_counts;
+  // Sends/retrieves per message bin (0 = non-ID, b = cell index b - 1)
+  MessageCounts send_counts;
+  MessageCounts recv_counts;
 
-  emp::Ptr<emp::DataMonitor<int>> send_other_mon;
-  emp::Ptr<emp::DataMonitor<int>> recv_other_mon;
-  int send_other_count = 0;
-  int recv_other_count = 0;
+  const int num_h_boxes = config.WORLD_LEN();
+  const int num_w_boxes = config.WORLD_WIDTH();
+  emp::Random random{config.SEED()};
 
-  const int num_h_boxes = worldConfig.WORLD_LEN();
-  const int num_w_boxes = worldConfig.WORLD_WIDTH();
-  emp::Random random{worldConfig.SEED()};
+  // Storage for every organism in the world, one slot per cell
+  ObjectPool<Organism> organism_pool{static_cast<size_t>(num_w_boxes * num_h_boxes)};
 
-  std::vector<std::vector<Cell *>> cell_grid = std::vector<std::vector<Cell *>>(num_w_boxes, std::vector<Cell *>(num_h_boxes));
+  CellGrid cell_grid;
+  // Bounded message queues by cell, when INBOX_CAPACITY > 0
+  InboxRing inboxes;
+  // Points and occupied ID range of the live organisms, kept up to date as they change
+  PopulationStats pop_stats;
+  UpdateScheduler scheduler;
+  CpuBudget cpu_budget;
+  // CPU cycles run by all organisms since the world was made
+  uint64_t total_cycles = 0;
+  // Births, deaths, sends and retrieves since the world was made, and how many
+  // updates in a row have gone by without any
+  uint64_t num_events = 0;
+  size_t quiet_updates = 0;
   unsigned int max_id;
   unsigned int min_id;
-  // direction‐vectors for 8 neighbors:
-  static constexpr int dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
-  static constexpr int dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+  // Tiled parallel update (THREAD_NUM > 0), see Parallel.h
+  TilePlan tile_plan;
+  std::vector<TileTally> tile_tallies;
+  emp::Ptr<WorkerPool> worker_pool = nullptr;
+  const std::vector<size_t> *current_color = nullptr;
+  std::function<void(size_t)> process_tile_job;
+  bool in_parallel_phase = false;
+
+  // The CSV data files opened with OpenDataFile (owned by emp::World)
+  std::vector<emp::DataFile *> data_files;
+  // Binary data files (DATA_FORMAT "binary"), updated next to emp's own files
+  std::vector<emp::Ptr<SparseDataFile>> sparse_files;
+  std::vector<std::string> sparse_file_names;
+
+  // Checkpoints are written in the background by this writer
+  AsyncFileWriter checkpoint_writer;
+  // Data file offsets (and last recorded update) from a loaded checkpoint,
+  // applied as each file is set up again
+  std::map<std::string, std::pair<uint64_t, uint64_t>> resume_offsets;
+
+  // Only set when TRACE_FILE is given
+  emp::Ptr<EventTracer> tracer = nullptr;
+  emp::Ptr<UpdateProfiler> profiler = nullptr;
 
 public:
   /**
-   * Input: A random number generator
+   * Input: A random number generator and the settings of this run
    *
    * Output: None
    *
    * Purpose: Constructor for the world. Sets up the tasks and monitors.
    */
-  OrgWorld(emp::Random &_random) : emp::World<Organism>(_random)
+  OrgWorld(emp::Random &_random, const MyConfigType &cfg) : emp::World<Organism>(_random), config(cfg)
   {
-    AddTask(new Initial());
-    // AddTask(new TargetAnother());
-    // AddTask(new FaceAnother());
-    // AddTask(new PrepMessage());
-    // AddTask(new PrepHighest());
-    // AddTask(new SendHighest());
-    AddTask(new SendNonID());
-    // AddTask(new SendSelf());
-    AddTask(new SendID());
-    AddTask(new MaxKnown());
+    ActiveTaskSet::ForEachTask([this](Task *task)
+                               { AddTask(task); });
 
     SetupWorld();
     SetupCellGrid();
-    LinkAllNeighbors();
     SetupSendRecvMonitors();
-    
+    inboxes.Setup(GetSize(), std::max(config.INBOX_CAPACITY(), 0));
+    pop_stats.Resize(GetSize());
+    scheduler.Setup(config.SCHEDULE(), GetSize());
+    cpu_budget.Setup(config);
+    SetupParallelUpdate();
+    SetupEventTrace();
+    SetupProfiler();
   }
 
   /**
@@ -77,67 +141,121 @@ public:
    *
    * Purpose: Destructor for the world.
    */
-  ~OrgWorld() {}
+  ~OrgWorld()
+  {
+    // Hand organisms back to the pool before emp::World tries to delete them
+    for (size_t i = 0; i < pop.size(); ++i)
+    {
+      if (pop[i])
+      {
+        organism_pool.Release(pop[i]);
+        pop[i] = nullptr;
+      }
+    }
+    for (Task *task : tasks)
+      delete task;
+    for (auto monitor : solve_monitors)
+      monitor.Delete();
+    if (worker_pool)
+      worker_pool.Delete();
+    if (tracer)
+      tracer.Delete();
+    if (profiler)
+      profiler.Delete();
+    for (auto file : sparse_files)
+      file.Delete();
+  }
 
   /**
    * Input: None
    *
    * Output: None
    *
-   * Purpose: Setup data monitor for messages being sent and retrieved
+   * Purpose: Start the message event trace, when a trace file is configured.
    */
-  void SetupSendRecvMonitors(){
-    const int total_cells = num_w_boxes * num_h_boxes;
-    send_counts.assign(total_cells, 0);
-    recv_counts.assign(total_cells, 0);
-    send_monitors.resize(total_cells);
-    recv_monitors.resize(total_cells);
+  void SetupEventTrace()
+  {
+    if (config.TRACE_FILE().empty())
+      return;
+    tracer.New(config.TRACE_FILE(), config.TRACE_BUFFER());
+  }
 
-    for (int i = 0; i < total_cells; ++i)
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Start the per-phase update profiler, when a profile file is configured.
+   */
+  void SetupProfiler()
+  {
+    if (config.PROFILE_FILE().empty())
+      return;
+    profiler.New(config.PROFILE_FILE(), std::max(config.PROFILE_FREQUENCY(), 1), GetSize());
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Build the tiles and worker threads for the parallel update, when enabled.
+   */
+  void SetupParallelUpdate()
+  {
+    if (config.THREAD_NUM() <= 0)
+      return;
+    tile_plan.Build(num_w_boxes, num_h_boxes, config.TILE_SIZE());
+    tile_tallies.resize(tile_plan.GetNumTiles());
+    for (TileTally &tally : tile_tallies)
     {
-      send_monitors[i].New();
-      recv_monitors[i].New();
+      tally.solve_counts.assign(tasks.size(), 0);
+      tally.solver_counts.assign(tasks.size(), 0);
     }
+    worker_pool.New(config.THREAD_NUM());
+    process_tile_job = [this](size_t task)
+    { ProcessTile((*current_color)[task]); };
+  }
+
+  /**
+   * Input: An organism's location.
+   *
+   * Output: The tally its side effects go to, or nullptr outside the parallel phase.
+   *
+   * Purpose: Keep threads from sharing counters and queues while tiles run.
+   */
+  TileTally *ActiveTally(int location)
+  {
+    if (!in_parallel_phase)
+      return nullptr;
+    return &tile_tallies[tile_plan.tile_of[location]];
+  }
 
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Setup the message counters for messages being sent and retrieved
+   */
+  void SetupSendRecvMonitors(){
     all_cell_ids.reserve(num_w_boxes * num_h_boxes);
     for (int x = 0; x < num_w_boxes; ++x)
     {
       for (int y = 0; y < num_h_boxes; ++y)
       {
-        unsigned id = cell_grid[x][y]->GetID();
-        int idx = (int)all_cell_ids.size();
-        all_cell_ids.push_back(id);
-        id_to_idx[id] = idx;
+        all_cell_ids.push_back(cell_grid.GetID(x * num_h_boxes + y));
       }
     }
+    id_index.Build(all_cell_ids);
 
-    send_other_mon.New();
-    recv_other_mon.New();
+    send_counts.Resize(GetMsgBinCount());
+    recv_counts.Resize(GetMsgBinCount());
 
     OnUpdate([this](size_t)
              {
-    for (int i = 0; i < (int)send_monitors.size(); ++i) {
-      auto & m = *send_monitors[i];
-      m.Reset();
-      m.AddDatum( send_counts[i] );
-      send_counts[i] = 0;
-    }
-
-    for (int i = 0; i < (int)recv_monitors.size(); ++i) {
-      auto & m = *recv_monitors[i];
-      m.Reset();
-      m.AddDatum( recv_counts[i] );
-      recv_counts[i] = 0;
-    }
-
-    send_other_mon->Reset();
-    send_other_mon->AddDatum( send_other_count );
-    send_other_count = 0;
-
-    recv_other_mon->Reset();
-    recv_other_mon->AddDatum( recv_other_count );
-    recv_other_count = 0; });
-
+    send_counts.Rollover();
+    recv_counts.Rollover(); });
   }
 
   /**
@@ -148,13 +266,21 @@ public:
    * Purposes: To be called from other files
    */
   const pop_t &GetPopulation() { return pop; }
+  const MyConfigType &GetConfig() const { return config; }
   auto GetTasks() { return tasks; }
   auto GetSolveMonitors() { return solve_monitors; }
-  auto GetSendMonitors() { return send_monitors; }
-  auto GetRecvMonitors() { return recv_monitors; }
-  auto GetSendOtherMon() { return send_other_mon; }
-  auto GetRecvOtherMon() { return recv_other_mon; }
-  auto GetIdToIdx() { return &id_to_idx; }
+  size_t GetNumTasks() const { return tasks.size(); }
+  // Times a task was solved during the latest update
+  int GetSolveCount(size_t task) const { return task < solve_counts.size() ? solve_counts[task] : 0; }
+  // Organisms that solved a task during the latest update, however many times each did
+  int GetSolverCount(size_t task) const { return task < solver_counts.size() ? solver_counts[task] : 0; }
+  // Solves of a task in the last finished update, as the data files print them
+  int GetSolveTotal(size_t task) const { return static_cast<int>(solve_monitors[task]->GetTotal()); }
+  const MessageCounts &GetSendCounts() const { return send_counts; }
+  const MessageCounts &GetRecvCounts() const { return recv_counts; }
+  const IdIndex &GetIdIndex() const { return id_index; }
+  // Cell index of a cell ID, or -1 if the value isn't one
+  int GetCellIndexOfID(unsigned int value) const { return id_index.Find(value); }
   int GetMsgBinCount() const
   {
     return (int)all_cell_ids.size() + 1;
@@ -166,19 +292,47 @@ public:
     return "ID_" + std::to_string(all_cell_ids[b - 1]);
   }
 
-  Cell *GetCellByLinearIndex(int idx) const
+  Cell GetCellByLinearIndex(int idx)
   {
     const int total = num_w_boxes * num_h_boxes;
     if (idx < 0 || idx >= total)
-      return nullptr;
+      return Cell();
 
-    const int x = idx / num_h_boxes;
-    const int y = idx % num_h_boxes;
-    return cell_grid[x][y];
+    return Cell(&cell_grid, idx);
   }
-  Cell *GetCellByGridCoord(int x, int y)
+  Cell GetCellByGridCoord(int x, int y)
   {
-    return cell_grid[x][y];
+    return Cell(&cell_grid, x * num_h_boxes + y);
+  }
+  const CellGrid &GetCellGrid() const { return cell_grid; }
+  const InboxRing &GetInboxes() const { return inboxes; }
+  const PopulationStats &GetPopulationStats() const { return pop_stats; }
+
+  /**
+   * Input: The view to fill
+   *
+   * Output: None
+   *
+   * Purpose: Gather the fields renderers read (best task, message and points of
+   * every organism, plus the cells' IDs and facings) into flat arrays, without
+   * copying any organism.
+   */
+  void FillRenderView(RenderView &view) const
+  {
+    view.num_cells = GetSize();
+    view.cell_ids = cell_grid.GetIDs().data();
+    view.facings = cell_grid.GetFacings().data();
+    view.best_task.resize(view.num_cells);
+    view.message.resize(view.num_cells);
+    view.points.resize(view.num_cells);
+    view.live.clear();
+    cell_grid.ForEachOccupied([this, &view](size_t i)
+                              {
+      const OrgState &state = pop[i]->GetState();
+      view.live.push_back(static_cast<uint32_t>(i));
+      view.best_task[i] = static_cast<uint32_t>(state.best_task);
+      view.message[i] = state.message;
+      view.points[i] = state.points; });
   }
 
   unsigned int GetMaxID() { return max_id; }
@@ -210,6 +364,7 @@ public:
 
     const size_t idx = tasks.size() - 1;
     solve_counts.resize(tasks.size(), 0);
+    solver_counts.resize(tasks.size(), 0);
     solve_monitors.resize(tasks.size());
     solve_monitors[idx].New();
     auto &dm = *solve_monitors[idx];
@@ -218,7 +373,8 @@ public:
              {
       dm.Reset();
       dm.AddDatum( solve_counts[idx] );
-      solve_counts[idx] = 0; });
+      solve_counts[idx] = 0;
+      solver_counts[idx] = 0; });
   }
 
   /**
@@ -237,13 +393,23 @@ public:
   }
   void RecordSend(int cell_idx)
   {
-    if (cell_idx >= 0 && cell_idx < (int)send_counts.size())
-      ++send_counts[cell_idx];
+    ++num_events;
+    if (profiler)
+      ++profiler->counts.sends;
+    if (cell_idx >= 0 && cell_idx < (int)all_cell_ids.size())
+      send_counts.Add(cell_idx + 1);
+    else
+      send_counts.Add(0);
   }
   void RecordReceive(int cell_idx)
   {
-    if (cell_idx >= 0 && cell_idx < (int)recv_counts.size())
-      ++recv_counts[cell_idx];
+    ++num_events;
+    if (profiler)
+      ++profiler->counts.receives;
+    if (cell_idx >= 0 && cell_idx < (int)all_cell_ids.size())
+      recv_counts.Add(cell_idx + 1);
+    else
+      recv_counts.Add(0);
   }
 
   /**
@@ -255,7 +421,8 @@ public:
    */
   emp::DataFile &SetupSolveFile(const std::string &filename)
   {
-    auto &file = SetupFile(filename);
+    const bool resumed = resume_offsets.count(filename);
+    auto &file = OpenDataFile(filename);
     file.AddVar(update, "update", "Update step");
 
     for (size_t i = 0; i < tasks.size(); ++i)
@@ -263,54 +430,186 @@ public:
       const std::string name = tasks[i]->name();
       file.AddTotal(*solve_monitors[i], "solves_" + name, "Total solves of " + name);
     }
-    file.PrintHeaderKeys();
+    if (!resumed)
+      file.PrintHeaderKeys();
     return file;
   }
 
   emp::DataFile &SetupSendRecvFile(const std::string &filename)
   {
-    auto &file = SetupFile(filename);
+    const bool resumed = resume_offsets.count(filename);
+    auto &file = OpenDataFile(filename);
     file.AddVar(update, "update", "Update step");
 
   for (size_t i = 0; i < all_cell_ids.size(); ++i) {
     const auto id = all_cell_ids[i];
-    file.AddTotal(*send_monitors[i],
-                  "send_ID_" + std::to_string(id),
-                  "Sends to cell " + std::to_string(id));
-    file.AddTotal(*recv_monitors[i],
-                  "recv_ID_" + std::to_string(id),
-                  "Retrieves from cell " + std::to_string(id));
+    const int bin = (int)i + 1;
+    file.AddFun<int>([this, bin]() { return send_counts.GetLast(bin); },
+                     "send_ID_" + std::to_string(id),
+                     "Sends to cell " + std::to_string(id));
+    file.AddFun<int>([this, bin]() { return recv_counts.GetLast(bin); },
+                     "recv_ID_" + std::to_string(id),
+                     "Retrieves from cell " + std::to_string(id));
   }
 
-  file.AddTotal(*send_other_mon, "send_other", "Sends to non‐cell ID");
-  file.AddTotal(*recv_other_mon, "recv_other", "Retrieves non‐cell ID");
+  file.AddFun<int>([this]() { return send_counts.GetLast(0); }, "send_other", "Sends to non‐cell ID");
+  file.AddFun<int>([this]() { return recv_counts.GetLast(0); }, "recv_other", "Retrieves non‐cell ID");
 
-  file.PrintHeaderKeys();
+  if (!resumed)
+    file.PrintHeaderKeys();
   return file;
   }
 
+  /**
+   * Input: A filename string
+   *
+   * Output: A Datafile
+   *
+   * Purpose: Track the population's point stats and occupied ID range. The
+   * values come from the running population stats, so recording them doesn't
+   * scan the population.
+   */
+  emp::DataFile &SetupPopulationFile(const std::string &filename)
+  {
+    const bool resumed = resume_offsets.count(filename);
+    auto &file = OpenDataFile(filename);
+    file.AddVar(update, "update", "Update step");
+    file.AddFun<size_t>([this]() { return pop_stats.GetCount(); }, "count", "Number of organisms");
+    file.AddFun<double>([this]() { return pop_stats.GetMinPoints(); }, "points_min", "Fewest points of an organism");
+    file.AddFun<double>([this]() { return pop_stats.GetMaxPoints(); }, "points_max", "Most points of an organism");
+    file.AddFun<double>([this]() { return pop_stats.GetMean(); }, "points_mean", "Mean points");
+    file.AddFun<double>([this]() { return pop_stats.GetVariance(); }, "points_variance", "Variance of points");
+    file.AddFun<unsigned int>([this]() { return pop_stats.GetMinID(); }, "min_id", "Lowest ID of an occupied cell");
+    file.AddFun<unsigned int>([this]() { return pop_stats.GetMaxID(); }, "max_id", "Highest ID of an occupied cell");
+    file.AddFun<size_t>([this]() { return GetPoolStats().in_use; }, "pool_in_use", "Organisms held by the organism pool");
+    file.AddFun<size_t>([this]() { return GetPoolStats().peak_in_use; }, "pool_peak", "Most organisms the pool has held at once");
+    file.AddFun<size_t>([this]() { return GetPoolStats().overflow; }, "pool_overflow", "Organisms that went to the heap because the pool was full");
+    if (!resumed)
+      file.PrintHeaderKeys();
+    return file;
+  }
+
+  /**
+   * Input: A filename string
+   *
+   * Output: A Datafile writing to a stream owned by the world
+   *
+   * Purpose: Like emp's SetupFile, but keeps hold of the stream so checkpoints can
+   * record its offset. After LoadCheckpoint the file is cut back to that offset
+   * and appended to instead.
+   */
+  emp::DataFile &OpenDataFile(const std::string &filename)
+  {
+    auto resume = resume_offsets.find(filename);
+    if (resume != resume_offsets.end())
+    {
+      std::filesystem::resize_file(filename, resume->second.first);
+      data_streams.push_back(std::make_unique<std::ofstream>(filename, std::ios::app));
+      data_streams.back()->seekp(0, std::ios::end);
+    }
+    else
+    {
+      data_streams.push_back(std::make_unique<std::ofstream>(filename));
+    }
+    data_stream_names.push_back(filename);
+    emp::DataFile &file = AddDataFile(emp::NewPtr<emp::DataFile>(*data_streams.back()));
+    data_files.push_back(&file);
+    return file;
+  }
+
+  /**
+   * Input: A filename string
+   *
+   * Output: A binary SparseDataFile
+   *
+   * Purpose: Same columns as SetupSolveFile, written in the sparse binary format
+   */
+  SparseDataFile &SetupSolveSparseFile(const std::string &filename)
+  {
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      columns.push_back("solves_" + tasks[i]->name());
+    }
+    return AddSparseFile(filename, columns, [this](SparseDataFile &file)
+                         {
+      for (size_t i = 0; i < solve_monitors.size(); ++i)
+        file.Put(i, static_cast<int64_t>(solve_monitors[i]->GetTotal())); });
+  }
+
+  /**
+   * Input: A filename string
+   *
+   * Output: A binary SparseDataFile
+   *
+   * Purpose: Same columns as SetupSendRecvFile, written in the sparse binary
+   * format. Only the bins that saw traffic are visited for each row.
+   */
+  SparseDataFile &SetupSendRecvSparseFile(const std::string &filename)
+  {
+    const size_t num_cells = all_cell_ids.size();
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < num_cells; ++i)
+    {
+      columns.push_back("send_ID_" + std::to_string(all_cell_ids[i]));
+      columns.push_back("recv_ID_" + std::to_string(all_cell_ids[i]));
+    }
+    columns.push_back("send_other");
+    columns.push_back("recv_other");
+
+    // Bin b > 0 is cell b - 1, whose columns are 2(b - 1) and 2(b - 1) + 1
+    auto column_of = [num_cells](int bin)
+    { return bin ? 2 * (size_t)(bin - 1) : 2 * num_cells; };
+    return AddSparseFile(filename, columns, [this, column_of](SparseDataFile &file)
+                         {
+      const SparseCounter &sends = send_counts.GetLast();
+      const SparseCounter &recvs = recv_counts.GetLast();
+      for (int bin : sends.GetActive())
+        file.Put(column_of(bin), sends.Get(bin));
+      for (int bin : recvs.GetActive())
+        file.Put(column_of(bin) + 1, recvs.Get(bin)); });
+  }
+
+  SparseDataFile &AddSparseFile(const std::string &filename, const std::vector<std::string> &columns,
+                                SparseDataFile::fill_fun_t fill)
+  {
+    emp::Ptr<SparseDataFile> file;
+    auto resume = resume_offsets.find(filename);
+    if (resume != resume_offsets.end())
+    {
+      std::filesystem::resize_file(filename, resume->second.first);
+      file.New(filename, columns, fill, true);
+      file->SetLastUpdate(resume->second.second);
+    }
+    else
+    {
+      file.New(filename, columns, fill);
+    }
+    sparse_files.push_back(file);
+    sparse_file_names.push_back(filename);
+    return *file;
+  }
+
   /**
    * Input: None
    *
    * Output: None
    *
-   * Purpose: Setup the cell grid, iterate through them and set linear index equivalent to how organism indices are set.
+   * Purpose: Setup the cell grid, giving each cell (at the same linear index as organisms) a random facing and ID.
    */
   void SetupCellGrid()
   {
+    cell_grid.Resize(num_w_boxes, num_h_boxes);
     int org_num = 0;
     for (int x = 0; x < num_w_boxes; x++)
     {
       for (int y = 0; y < num_h_boxes; y++)
       {
-        Cell *new_cell = new Cell();
-        new_cell->SetIndex(org_num);
         int random_dir = static_cast<int>(random.GetUInt(8));
-        new_cell->SetFacing(random_dir);
+        cell_grid.SetFacing(org_num, random_dir);
         unsigned int random_id = random.GetUInt();
-        new_cell->SetID(random_id);
-        cell_grid[x][y] = new_cell;
-        unsigned int new_id = new_cell->GetID();
+        cell_grid.SetID(org_num, random_id);
+        unsigned int new_id = random_id;
         if (max_id)
         {
           max_id = std::max(max_id, new_id);
@@ -334,69 +633,252 @@ public:
 
   /**
    * Input: None
-   * 
+   *
+   * Output: The position of the new organism
+   *
+   * Purpose: Add an ancestor with a random genome to a random cell, replacing
+   * any organism there. Like emp's Inject it draws one cell, so seeded runs
+   * place their ancestors the same way; use this rather than Inject so the
+   * organism lives in the pool.
+   */
+  emp::WorldPosition InjectOrganism()
+  {
+    emp::Ptr<Organism> org = organism_pool.Acquire(this, config);
+    const size_t pos = GetRandom().GetUInt(GetSize());
+    PlaceAncestor(org, pos);
+    return emp::WorldPosition(pos);
+  }
+
+  /**
+   * Input: Index of a cell
+   *
    * Output: None
-   * 
-   * Purpoose: Set up pointers conncting each cell to its neighbors.
+   *
+   * Purpose: Add an ancestor with a random genome to the given cell, replacing
+   * any organism there.
    */
-  void LinkAllNeighbors()
+  void InjectOrganismAt(size_t pos)
   {
-    for (int x = 0; x < num_w_boxes; ++x)
-    {
-      for (int y = 0; y < num_h_boxes; ++y)
-      {
-        Cell *C = cell_grid[x][y];
-        for (int dir = 0; dir < 8; ++dir)
-        {
-          int nx = emp::Mod(x + dx[dir], num_w_boxes);
-          int ny = emp::Mod(y + dy[dir], num_h_boxes);
-          C->SetConnection(dir, cell_grid[nx][ny]);
-        }
-      }
-    }
+    PlaceAncestor(organism_pool.Acquire(this, config), pos);
+  }
+
+  void PlaceAncestor(emp::Ptr<Organism> org, size_t pos)
+  {
+    if (IsOccupied(pos))
+      RemoveOrganism(pos);
+    AddOrgAt(org, emp::WorldPosition(pos));
+    BindOrganismToCell(pos);
   }
 
   /**
-   * Input: index of a known organism.
+   * Input: index of an occupied cell.
    *
-   * Output: the organism at the index
+   * Output: None
    *
-   * Purpose: Removes the organism from the world but keeping a reference to it.
+   * Purpose: Link the organism there with its cell and mark the cell occupied.
+   * Every path that places an organism calls this, and every path that removes
+   * one clears the cell, so the bindings never need a sweep over the grid. The
+   * new organism starts with an empty inbox, and is counted in the population
+   * stats.
    */
-  emp::Ptr<Organism> ExtractOrganism(int i)
+  void BindOrganismToCell(size_t i)
+  {
+    Cell cell = GetCellByLinearIndex(i);
+    pop[i]->SetCell(cell);
+    cell.SetHasOrg(true);
+    pop_stats.Add(i, pop[i]->GetPoints(), cell.GetID());
+    if (inboxes.IsEnabled())
+      inboxes.Clear(i);
+  }
+
+  /**
+   * Input: index of an occupied cell.
+   *
+   * Output: None
+   *
+   * Purpose: Remove the organism there and return its storage to the pool.
+   */
+  void RemoveOrganism(size_t i)
   {
     emp::Ptr<Organism> org = pop[i];
     pop[i] = nullptr;
-    Cell *blank_cell = org->GetCell();
-    org->SetCell(nullptr);
-    blank_cell->SetHasOrg(false);
-    return org;
+    --num_orgs;
+    cell_grid.SetHasOrg(i, false);
+    pop_stats.Remove(i);
+    organism_pool.Release(org);
+  }
+
+  /**
+   * Input: index of an organism that has run out of points.
+   *
+   * Output: None
+   *
+   * Purpose: Remove the organism from the world. During the parallel update its
+   * storage goes back to the pool once all tiles are done.
+   */
+  void KillOrganism(size_t i)
+  {
+    if (TileTally *tally = ActiveTally(i))
+    {
+      tally->deaths.push_back(pop[i]);
+      pop[i] = nullptr;
+      cell_grid.SetHasOrg(i, false);
+      return;
+    }
+    ++num_events;
+    if (profiler)
+      ++profiler->counts.deaths;
+    RemoveOrganism(i);
   }
 
+  const PoolStats &GetPoolStats() const { return organism_pool.GetStats(); }
+  uint64_t GetTotalCycles() const { return total_cycles; }
+
   /**
    * Input: None
    *
    * Output: None
    *
-   * Purpose: Runs Process() on all organisms in the world at random order.
+   * Purpose: Runs Process() on all organisms in the world, in the order the
+   * SCHEDULE setting picks.
    */
   void ProcessAllOrganisms()
   {
-    emp::vector<size_t> schedule = emp::GetPermutation(GetRandom(), GetSize());
-    for (int i : schedule)
+    const emp::vector<size_t> &schedule = scheduler.Build(cell_grid, GetRandom());
+    for (size_t i : schedule)
     {
       if (!IsOccupied(i))
       {
         continue;
       }
-      pop[i]->Process(i);
+      total_cycles += pop[i]->Process(i, cpu_budget);
       if (pop[i]->GetPoints() < 0)
       {
-        ExtractOrganism(i);
+        KillOrganism(i);
+      }
+      else
+      {
+        pop_stats.SetPoints(i, pop[i]->GetPoints());
       }
     }
   }
 
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Runs Process() on all organisms, one tile color at a time with the
+   * tiles of each color spread over the worker threads.
+   */
+  void ProcessAllOrganismsParallel()
+  {
+    // Seeds are drawn in tile order so they don't depend on the thread count
+    if (config.DETERMINISTIC())
+    {
+      for (TileTally &tally : tile_tallies)
+      {
+        tally.seed = static_cast<int>(GetRandom().GetUInt(0x7ffffffe)) + 1;
+      }
+    }
+    // This thread runs tiles too, reseeding its sgpl::tlrand for each one, so
+    // its stream is put back afterwards for the serial reproduce phase
+    const emp::Random main_tlrand = sgpl::tlrand.Get();
+    in_parallel_phase = true;
+    for (const std::vector<size_t> &color : tile_plan.color_tiles)
+    {
+      current_color = &color;
+      worker_pool->Run(color.size(), process_tile_job);
+    }
+    in_parallel_phase = false;
+    if (config.DETERMINISTIC())
+      sgpl::tlrand.Get() = main_tlrand;
+    MergeTileTallies();
+  }
+
+  /**
+   * Input: Index of a tile.
+   *
+   * Output: None
+   *
+   * Purpose: Runs Process() on the organisms of one tile at random order.
+   */
+  void ProcessTile(size_t tile)
+  {
+    emp::vector<size_t> &cells = tile_plan.tile_cells[tile];
+    if (config.DETERMINISTIC())
+    {
+      emp::Random tile_random(tile_tallies[tile].seed);
+      emp::Shuffle(tile_random, cells);
+      sgpl::tlrand.Get().ResetSeed(static_cast<int>(tile_random.GetUInt(0x7ffffffe)) + 1);
+    }
+    else
+    {
+      emp::Shuffle(sgpl::tlrand.Get(), cells);
+    }
+    for (size_t i : cells)
+    {
+      if (!IsOccupied(i))
+      {
+        continue;
+      }
+      tile_tallies[tile].cycles += pop[i]->Process(i, cpu_budget);
+      if (pop[i]->GetPoints() < 0)
+      {
+        KillOrganism(i);
+      }
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Fold the per-tile tallies back into the world in tile order, and
+   * bring the population stats up to date with the tiles' organisms.
+   */
+  void MergeTileTallies()
+  {
+    for (size_t t = 0; t < tile_tallies.size(); ++t)
+    {
+      TileTally &tally = tile_tallies[t];
+      for (size_t i : tile_plan.tile_cells[t])
+      {
+        if (pop[i])
+          pop_stats.SetPoints(i, pop[i]->GetPoints());
+        else
+          pop_stats.Remove(i);
+      }
+      reproduce_queue.insert(reproduce_queue.end(), tally.reproduce_queue.begin(), tally.reproduce_queue.end());
+      tally.reproduce_queue.clear();
+      total_cycles += tally.cycles;
+      tally.cycles = 0;
+      for (size_t i = 0; i < tally.solve_counts.size(); ++i)
+      {
+        solve_counts[i] += tally.solve_counts[i];
+        tally.solve_counts[i] = 0;
+        solver_counts[i] += tally.solver_counts[i];
+        tally.solver_counts[i] = 0;
+      }
+      for (int idx : tally.send_events)
+        RecordSend(idx);
+      tally.send_events.clear();
+      for (int idx : tally.recv_events)
+        RecordReceive(idx);
+      tally.recv_events.clear();
+      num_events += tally.deaths.size();
+      if (profiler)
+        profiler->counts.deaths += tally.deaths.size();
+      for (emp::Ptr<Organism> org : tally.deaths)
+      {
+        --num_orgs;
+        organism_pool.Release(org);
+      }
+      tally.deaths.clear();
+    }
+  }
+
   /**
    * Input: None
    *
@@ -412,35 +894,58 @@ public:
       {
         return;
       }
-      Organism *org = pop[location.GetIndex()];
-      std::optional<Organism> offspring =
-          org->CheckReproduction();
-      if (offspring.has_value())
-      {
-        DoBirth(offspring.value(), location.GetIndex());
-        org->AddReproduced(1);
-      }
+      const size_t parent_pos = location.GetIndex();
+      emp::WorldPosition birth_pos = BirthOffspring(parent_pos);
+      // A parent that was replaced by its own offspring is gone
+      if (birth_pos.GetIndex() != parent_pos)
+        pop[parent_pos]->AddReproduced(1);
     }
     reproduce_queue.clear();
   }
 
   /**
-   * Input: None
+   * Input: The position of a parent that is ready to reproduce.
    *
-   * Output: None
+   * Output: The position of the offspring.
    *
-   * Purpose: Establish link between organisms and cells so their data can be used together
+   * Purpose: Place a mutated copy of the parent in a random neighbouring cell.
+   * An organism already in that cell is turned into the offspring in place, so
+   * the usual birth into an occupied cell copies nothing but the program and
+   * allocates nothing. It stays in the same cell, so occupancy doesn't
+   * change, but the reset state has to be bound to the cell again. Births
+   * into empty cells do the same with an idle organism from the pool, and only
+   * construct a new one, straight from the parent's program, when there is none.
    */
-  void BindAllOrganismsToCell()
+  emp::WorldPosition BirthOffspring(size_t parent_pos)
   {
-    for (int i = 0; i < GetSize(); i++)
+    const emp::WorldPosition pos = GetRandomNeighborPos(emp::WorldPosition(parent_pos));
+    const Organism &parent = *pop[parent_pos];
+    ++num_events;
+    if (profiler)
+      ++profiler->counts.births;
+    if (IsOccupied(pos))
     {
-      if (!IsOccupied(i))
-        continue;
-      Cell *cur_cell = GetCellByLinearIndex(i);
-      pop[i]->SetCell(cur_cell);
-      cur_cell->SetHasOrg(true);
+      // The occupant is replaced, which counts as its death
+      if (profiler)
+        ++profiler->counts.deaths;
+      pop[pos.GetIndex()]->InheritFrom(parent);
+    }
+    else
+    {
+      emp::Ptr<Organism> offspring = organism_pool.AcquireIdle();
+      if (offspring)
+      {
+        offspring->InheritFrom(parent);
+      }
+      else
+      {
+        offspring = organism_pool.Acquire(this, parent.GetProgram(), config);
+        offspring->Mutate();
+      }
+      AddOrgAt(offspring, pos, emp::WorldPosition(parent_pos));
     }
+    BindOrganismToCell(pos.GetIndex());
+    return pos;
   }
 
   /**
@@ -452,33 +957,465 @@ public:
    */
   void Update()
   {
+    for (auto file : sparse_files)
+      file->Update(update);
+    const uint64_t cycles_before = total_cycles;
+    const uint64_t events_before = num_events;
+    if (profiler)
+      profiler->StartUpdate(num_orgs);
     emp::World<Organism>::Update();
-    this->BindAllOrganismsToCell();
-    this->ProcessAllOrganisms();
+    if (profiler)
+    {
+      profiler->EndPhase(PHASE_SIGNALS);
+      // Every organism alive now gets processed once
+      profiler->counts.org_processes += num_orgs;
+    }
+    if (worker_pool)
+      this->ProcessAllOrganismsParallel();
+    else
+      this->ProcessAllOrganisms();
+    if (profiler)
+      profiler->EndPhase(PHASE_PROCESS);
     this->ReproduceAllValidOrganisms();
+    if (profiler)
+    {
+      profiler->EndPhase(PHASE_REPRODUCE);
+      profiler->counts.cpu_cycles += total_cycles - cycles_before;
+      profiler->EndUpdate(update);
+    }
+    quiet_updates = (num_events == events_before) ? quiet_updates + 1 : 0;
   }
 
+  // Updates in a row without a birth, death, send or retrieve. Starts from 0
+  // again after LoadCheckpoint.
+  size_t GetQuietUpdates() const { return quiet_updates; }
+
   /**
    * Input: None
    *
+   * Output: Whether every future update would change nothing but the update counter
+   *
+   * Purpose: True once the population is extinct and the counts the data
+   * files print have all drained to zero.
+   */
+  bool IsFrozen() const
+  {
+    if (num_orgs || !reproduce_queue.empty())
+      return false;
+    for (const MessageCounts *counts : {&send_counts, &recv_counts})
+    {
+      if (!counts->GetCurrent().GetActive().empty() || !counts->GetLast().GetActive().empty())
+        return false;
+    }
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      if (solve_counts[i] || solve_monitors[i]->GetTotal())
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * Input: The update to skip to
+   *
    * Output: None
    *
-   * Purpose: Make all organisms that can reproduce, do so at a random order.
+   * Purpose: Skip the updates of a frozen world. The CSV data files still get
+   * every row they would have printed, and each binary data file gets a single
+   * run record in place of its all-zero rows.
+   */
+  void FastForward(size_t target)
+  {
+    if (!IsFrozen() || target <= update)
+      return;
+    for (auto file : sparse_files)
+      file->PutEmptyRows(update, target);
+    // The files read the update column from the world's counter
+    const size_t from = update;
+    for (size_t u = from; u < target; ++u)
+    {
+      update = u;
+      for (emp::DataFile *file : data_files)
+        file->Update(u);
+    }
+    update = target;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Score an organism's message on every task and record the solves.
    */
   void CheckOutput(OrgState &state)
   {
+    TileTally *tally = ActiveTally(state.current_location.GetIndex());
 
-    for (size_t i = 0; i < tasks.size(); ++i)
+    const TaskResult result = ActiveTaskSet::Evaluate(state);
+    state.points += result.points;
+    for (uint32_t solved = result.solved; solved; solved &= solved - 1)
+      CountSolve(state, tally, __builtin_ctz(solved));
+
+    // Tasks added with AddTask beyond the compiled set go through Task::CheckOutput
+    for (size_t i = ActiveTaskSet::size; i < tasks.size(); ++i)
     {
       double pts = tasks[i]->CheckOutput(state);
 
       if (pts != 0.0)
       {
         state.points += pts;
-        RecordSolve(i);
-        state.best_task = std::max(state.best_task, i);
+        CountSolve(state, tally, i);
+      }
+    }
+  }
+
+  /**
+   * Input: The solving organism's state, its tile's tally (nullptr outside the
+   * parallel update) and the task
+   *
+   * Output: None
+   *
+   * Purpose: Count a solve, and the organism as a solver of the task if this is
+   * its first solve of it this update.
+   */
+  void CountSolve(OrgState &state, TileTally *tally, size_t task)
+  {
+    if (state.solved_update != update)
+    {
+      state.solved_update = update;
+      state.solved_tasks = 0;
+    }
+    const uint64_t bit = task < 64 ? uint64_t(1) << task : 0;
+    const bool first = !(state.solved_tasks & bit);
+    state.solved_tasks |= bit;
+    if (tally)
+    {
+      ++tally->solve_counts[task];
+      tally->solver_counts[task] += first;
+    }
+    else
+    {
+      RecordSolve(task);
+      solver_counts[task] += first;
+    }
+    state.best_task = std::max(state.best_task, task);
+  }
+
+  /**
+   * Input: A filename string
+   *
+   * Output: None
+   *
+   * Purpose: Save the whole simulation state between updates. The image is built
+   * here and written to disk in the background.
+   *
+   * The running simulation is left untouched, so turning checkpoints on doesn't
+   * change a run. The world RNG and this thread's sgpl::tlrand are saved as
+   * they are, so a resumed run draws the same numbers the uninterrupted run
+   * would have. The one thing not saved is the sgpl cores: their state isn't
+   * reachable through sgpl's interface, so LoadCheckpoint restarts every core
+   * from its program, and that is where a resumed run parts from the
+   * uninterrupted one. It is still reproducible from its checkpoint.
+   */
+  void SaveCheckpoint(const std::string &filename)
+  {
+    CheckpointWriter out;
+    out.PutRaw("ORGCHKPT", 8);
+    out.Put<uint32_t>(CHECKPOINT_VERSION);
+    out.Put<int32_t>(num_w_boxes);
+    out.Put<int32_t>(num_h_boxes);
+    out.Put<uint64_t>(update);
+    out.Put<emp::Random>(GetRandom());
+    out.Put<emp::Random>(sgpl::tlrand.Get());
+    out.Put<uint64_t>(total_cycles);
+    out.Put<uint64_t>(num_events);
+    out.Put<uint64_t>(quiet_updates);
+
+    for (int x = 0; x < num_w_boxes; ++x)
+    {
+      for (int y = 0; y < num_h_boxes; ++y)
+      {
+        out.Put<uint32_t>(cell_grid.GetID(x * num_h_boxes + y));
+        out.Put<int32_t>(cell_grid.GetFacing(x * num_h_boxes + y));
       }
     }
+    out.Put<uint32_t>(min_id);
+    out.Put<uint32_t>(max_id);
+
+    // Counts not yet published, and what the data files will print next
+    out.PutVector(solve_counts);
+    std::vector<int> solve_totals;
+    for (auto &monitor : solve_monitors)
+      solve_totals.push_back(static_cast<int>(monitor->GetTotal()));
+    out.PutVector(solve_totals);
+    PutMessageCounts(out, send_counts);
+    PutMessageCounts(out, recv_counts);
+
+    std::vector<uint32_t> queue;
+    for (emp::WorldPosition location : reproduce_queue)
+      queue.push_back(location.GetIndex());
+    out.PutVector(queue);
+
+    // The parallel update shuffles each tile's cells in place from update to update
+    out.Put<uint64_t>(tile_plan.GetNumTiles());
+    for (const auto &cells : tile_plan.tile_cells)
+      out.PutVector(std::vector<uint64_t>(cells.begin(), cells.end()));
+
+    out.Put<uint64_t>(data_streams.size() + sparse_files.size());
+    for (size_t i = 0; i < data_streams.size(); ++i)
+    {
+      data_streams[i]->flush();
+      out.PutString(data_stream_names[i]);
+      out.Put<uint64_t>(static_cast<uint64_t>(data_streams[i]->tellp()));
+      out.Put<uint64_t>(0);
+    }
+    for (size_t i = 0; i < sparse_files.size(); ++i)
+    {
+      out.PutString(sparse_file_names[i]);
+      out.Put<uint64_t>(sparse_files[i]->FlushAndGetOffset());
+      out.Put<uint64_t>(sparse_files[i]->GetLastUpdate());
+    }
+
+    std::vector<uint32_t> occupied;
+    for (size_t i = 0; i < pop.size(); ++i)
+    {
+      if (pop[i])
+        occupied.push_back(i);
+    }
+    out.PutVector(occupied);
+    for (uint32_t i : occupied)
+      PutOrganism(out, *pop[i]);
+    // Queued messages of each organism (none without INBOX_CAPACITY)
+    for (uint32_t i : occupied)
+      out.PutVector(inboxes.IsEnabled() ? inboxes.GetMessages(i) : std::vector<uint32_t>());
+
+    checkpoint_writer.Write(filename, std::move(out.GetBytes()));
+  }
+
+  /**
+   * Input: A filename string
+   *
+   * Output: Whether the checkpoint could be loaded
+   *
+   * Purpose: Restore a freshly constructed world (before any organisms are
+   * injected or data files set up) from SaveCheckpoint's output. Data files set
+   * up afterwards with the same names continue where the checkpoint left them.
+   */
+  bool LoadCheckpoint(const std::string &filename)
+  {
+    CheckpointReader in(filename);
+    char magic[8];
+    in.GetRaw(magic, 8);
+    if (!in.IsOk() || std::string(magic, 8) != "ORGCHKPT")
+      return false;
+    if (in.Get<uint32_t>() != CHECKPOINT_VERSION)
+      return false;
+    if (in.Get<int32_t>() != num_w_boxes || in.Get<int32_t>() != num_h_boxes)
+      return false;
+
+    const uint64_t saved_update = in.Get<uint64_t>();
+    const emp::Random saved_random = in.Get<emp::Random>();
+    const emp::Random saved_tlrand = in.Get<emp::Random>();
+    const uint64_t saved_cycles = in.Get<uint64_t>();
+    const uint64_t saved_events = in.Get<uint64_t>();
+    const uint64_t saved_quiet = in.Get<uint64_t>();
+
+    std::vector<std::pair<uint32_t, int32_t>> cells(num_w_boxes * num_h_boxes);
+    for (auto &cell : cells)
+    {
+      cell.first = in.Get<uint32_t>();
+      cell.second = in.Get<int32_t>();
+    }
+    const uint32_t saved_min_id = in.Get<uint32_t>();
+    const uint32_t saved_max_id = in.Get<uint32_t>();
+
+    std::vector<int> saved_solve_counts = in.GetVector<int>();
+    std::vector<int> solve_totals = in.GetVector<int>();
+    std::vector<int32_t> send_last = in.GetVector<int32_t>();
+    std::vector<int32_t> send_current = in.GetVector<int32_t>();
+    std::vector<int32_t> recv_last = in.GetVector<int32_t>();
+    std::vector<int32_t> recv_current = in.GetVector<int32_t>();
+    std::vector<uint32_t> queue = in.GetVector<uint32_t>();
+
+    std::vector<std::vector<uint64_t>> tile_orders(in.Get<uint64_t>());
+    for (auto &order : tile_orders)
+      order = in.GetVector<uint64_t>();
+
+    std::map<std::string, std::pair<uint64_t, uint64_t>> offsets;
+    const uint64_t num_files = in.Get<uint64_t>();
+    for (uint64_t i = 0; i < num_files && in.IsOk(); ++i)
+    {
+      std::string name = in.GetString();
+      const uint64_t offset = in.Get<uint64_t>();
+      offsets[name] = {offset, in.Get<uint64_t>()};
+    }
+
+    std::vector<uint32_t> occupied = in.GetVector<uint32_t>();
+    std::vector<emp::Ptr<Organism>> orgs;
+    for (size_t i = 0; i < occupied.size() && in.IsOk(); ++i)
+      orgs.push_back(GetOrganism(in));
+    std::vector<std::vector<uint32_t>> saved_inboxes(occupied.size());
+    for (size_t i = 0; i < occupied.size() && in.IsOk(); ++i)
+      saved_inboxes[i] = in.GetVector<uint32_t>();
+
+    if (!in.IsOk() || saved_solve_counts.size() != solve_counts.size() ||
+        solve_totals.size() != solve_monitors.size())
+    {
+      for (auto org : orgs)
+        if (org)
+          organism_pool.Release(org);
+      return false;
+    }
+
+    // Everything parsed, apply it
+    update = saved_update;
+    total_cycles = saved_cycles;
+    num_events = saved_events;
+    quiet_updates = saved_quiet;
+    for (size_t idx = 0; idx < cells.size(); ++idx)
+    {
+      Cell cell = GetCellByLinearIndex(idx);
+      cell.SetID(cells[idx].first);
+      cell.SetFacing(cells[idx].second);
+      cell.SetHasOrg(false);
+      all_cell_ids[idx] = cells[idx].first;
+    }
+    id_index.Build(all_cell_ids);
+    min_id = saved_min_id;
+    max_id = saved_max_id;
+
+    solve_counts = saved_solve_counts;
+    for (size_t i = 0; i < solve_monitors.size(); ++i)
+    {
+      solve_monitors[i]->Reset();
+      solve_monitors[i]->AddDatum(solve_totals[i]);
+    }
+    GetMessageCounts(send_counts, send_last, send_current);
+    GetMessageCounts(recv_counts, recv_last, recv_current);
+
+    reproduce_queue.clear();
+    for (uint32_t idx : queue)
+      reproduce_queue.push_back(emp::WorldPosition(idx));
+
+    if (tile_orders.size() == tile_plan.GetNumTiles())
+    {
+      for (size_t t = 0; t < tile_orders.size(); ++t)
+      {
+        if (tile_orders[t].size() == tile_plan.tile_cells[t].size())
+          tile_plan.tile_cells[t].assign(tile_orders[t].begin(), tile_orders[t].end());
+      }
+    }
+    resume_offsets = offsets;
+
+    for (size_t i = 0; i < pop.size(); ++i)
+    {
+      if (pop[i])
+        RemoveOrganism(i);
+    }
+    for (size_t i = 0; i < occupied.size(); ++i)
+    {
+      AddOrgAt(orgs[i], emp::WorldPosition(occupied[i]));
+      BindOrganismToCell(occupied[i]);
+      // Cores weren't saved, so they start over from the program
+      orgs[i]->RestartCores();
+      // Messages beyond this run's INBOX_CAPACITY are dropped
+      if (inboxes.IsEnabled())
+      {
+        for (uint32_t message : saved_inboxes[i])
+          inboxes.Push(occupied[i], message);
+        orgs[i]->SetInbox(inboxes.Front(occupied[i]));
+      }
+    }
+
+    // Last, since building the organisms above draws from both
+    GetRandom() = saved_random;
+    sgpl::tlrand.Get() = saved_tlrand;
+    return true;
+  }
+
+  void PutMessageCounts(CheckpointWriter &out, const MessageCounts &counts)
+  {
+    for (const SparseCounter *counter : {&counts.GetLast(), &counts.GetCurrent()})
+    {
+      std::vector<int32_t> pairs;
+      for (int bin : counter->GetActive())
+      {
+        pairs.push_back(bin);
+        pairs.push_back(counter->Get(bin));
+      }
+      out.PutVector(pairs);
+    }
+  }
+
+  void GetMessageCounts(MessageCounts &counts, const std::vector<int32_t> &last, const std::vector<int32_t> &current)
+  {
+    counts.Clear();
+    for (size_t i = 0; i + 1 < last.size(); i += 2)
+      counts.Add(last[i], last[i + 1]);
+    counts.Rollover();
+    for (size_t i = 0; i + 1 < current.size(); i += 2)
+      counts.Add(current[i], current[i + 1]);
+  }
+
+  void PutOrganism(CheckpointWriter &out, Organism &org)
+  {
+    const sgpl::Program<Spec> &program = org.GetProgram();
+    out.Put<uint64_t>(program.size());
+    out.PutRaw(program.data(), program.size() * sizeof(sgpl::Instruction<Spec>));
+
+    OrgState &state = org.GetState();
+    out.Put<double>(state.points);
+    out.Put<uint64_t>(state.best_task);
+    out.Put<uint64_t>(state.age);
+    out.Put<uint8_t>(state.task_done);
+    out.Put<int32_t>(state.reproduced);
+    out.Put<uint32_t>(state.current_location.GetIndex());
+    out.Put<int32_t>(state.facing);
+    out.Put<uint32_t>(state.message);
+    out.Put<uint32_t>(state.inbox);
+    out.Put<uint32_t>(state.retrieved);
+    std::vector<uint32_t> values;
+    state.retrieved_values.ForEach(all_cell_ids, [&values](unsigned int value, int)
+                                   { values.push_back(value); });
+    out.PutVector(values);
+    out.Put<uint32_t>(state.max_known);
+    out.Put<uint32_t>(state.banked_cycles);
+    out.Put<uint32_t>(state.banked_updates);
+  }
+
+  emp::Ptr<Organism> GetOrganism(CheckpointReader &in)
+  {
+    const uint64_t length = in.Get<uint64_t>();
+    if (!in.IsOk() || length > (1u << 24))
+      return nullptr;
+    // Filled with random instructions first, then overwritten; the RNGs are
+    // restored at the end of LoadCheckpoint anyway
+    sgpl::Program<Spec> program(length);
+    in.GetRaw(static_cast<void *>(program.data()), length * sizeof(sgpl::Instruction<Spec>));
+
+    emp::Ptr<Organism> org = organism_pool.Acquire(this, program, config);
+    OrgState &state = org->GetState();
+    state.points = in.Get<double>();
+    state.best_task = in.Get<uint64_t>();
+    state.age = in.Get<uint64_t>();
+    state.task_done = in.Get<uint8_t>();
+    state.reproduced = in.Get<int32_t>();
+    state.current_location = emp::WorldPosition(in.Get<uint32_t>());
+    state.facing = in.Get<int32_t>();
+    state.message = in.Get<uint32_t>();
+    state.message_idx = GetCellIndexOfID(state.message);
+    state.inbox = in.Get<uint32_t>();
+    state.retrieved = in.Get<uint32_t>();
+    std::vector<uint32_t> values = in.GetVector<uint32_t>();
+    std::vector<int> value_idx(values.size());
+    id_index.Classify(values.data(), value_idx.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+      state.retrieved_values.Insert(values[i], value_idx[i], GetSize());
+    state.max_known = in.Get<uint32_t>();
+    state.banked_cycles = in.Get<uint32_t>();
+    state.banked_updates = in.Get<uint32_t>();
+    return org;
   }
 
   void ReproduceOrg(emp::WorldPosition location)
@@ -487,7 +1424,10 @@ public:
     // reproduction. If reproduction happened immediately then the child could
     // ovewrite the parent, and then we would be running the code of a deleted
     // organism
-    reproduce_queue.push_back(location);
+    if (TileTally *tally = ActiveTally(location.GetIndex()))
+      tally->reproduce_queue.push_back(location);
+    else
+      reproduce_queue.push_back(location);
   }
 
   /**
@@ -495,36 +1435,44 @@ public:
    *
    * Output: 0 or 1 showing if a send is successful.
    *
-   * Purpose: Send a message, and custom print statements to write the report when the web version is broken.
+   * Purpose: Send a message, and record it in the message counts and the event trace.
+   * With INBOX_CAPACITY > 0 the message joins the back of the target's inbox,
+   * and the send fails if that is full; otherwise it replaces the inbox.
    */
   int SendMessage(int location, unsigned int message)
   {
     Organism *sender = pop[location];
-    Cell *sender_cell = sender->GetCell();
-    unsigned int sender_id = sender_cell->GetID();
-    int sender_idx = sender_cell->GetIndex();
+    Cell sender_cell = sender->GetCell();
+    unsigned int sender_id = sender_cell.GetID();
+    int sender_idx = sender_cell.GetIndex();
 
-    Cell *target_cell = sender_cell->GetFacingCell();
-    unsigned int target_id = target_cell->GetID();
-    int target_idx = target_cell->GetIndex();
+    const int message_idx = GetCellIndexOfID(message);
+    sender->GetState().message_idx = message_idx;
 
-    if (IsOccupied(target_idx) && target_cell->GetFacingCell() == sender_cell && message)
+    Cell target_cell = sender_cell.GetFacingCell();
+    unsigned int target_id = target_cell.GetID();
+    int target_idx = target_cell.GetIndex();
+
+    if (IsOccupied(target_idx) && target_cell.GetFacingCell() == sender_cell && message)
     {
-      auto it = id_to_idx.find(message);
-      std::string isID;
-      if (it != id_to_idx.end())
-      {
-        send_counts[it->second]++;
-        isID = " ID ";
-      }
+      if (!inboxes.IsEnabled())
+        pop[target_idx]->SetInbox(message);
+      else if (inboxes.Push(target_idx, message))
+        pop[target_idx]->SetInbox(inboxes.Front(target_idx));
       else
+        return 0;
+
+      const int bin = message_idx;
+      if (TileTally *tally = ActiveTally(location))
+        tally->send_events.push_back(bin);
+      else
+        RecordSend(bin);
+
+      if (tracer)
       {
-        send_other_count++;
-        isID = " No ";
+        tracer->Record(TraceRecord{update, TRACE_SEND, bin >= 0, 0,
+                                   sender_idx, sender_id, target_idx, target_id, message});
       }
-
-      std::cout << "Org " << sender_idx << "-" << sender_id << " sent " << message << isID << " to Org " << target_idx << "-" << target_id << std::endl;
-      pop[target_idx]->SetInbox(message);
       return 1;
     }
     return 0;
@@ -536,19 +1484,27 @@ public:
    * Output: None
    *
    * Purpose: Retrieve a message, and update the organism's knowledge pool of other cell-IDs.
+   * With INBOX_CAPACITY > 0 the message is taken out of the inbox and the next
+   * one becomes visible.
    */
   void RetrieveMessage(int location, unsigned int msg_id)
   {
     Organism *retriever = pop[location];
-    Cell *retriever_cell = retriever->GetCell();
-    unsigned int retriever_id = retriever_cell->GetID();
-    int retriever_idx = retriever_cell->GetIndex();
+    Cell retriever_cell = retriever->GetCell();
+    unsigned int retriever_id = retriever_cell.GetID();
+    int retriever_idx = retriever_cell.GetIndex();
     unsigned int inbox_content = retriever->GetInbox();
+    if (inboxes.IsEnabled())
+    {
+      inbox_content = inboxes.Pop(retriever_idx);
+      retriever->SetInbox(inboxes.Front(retriever_idx));
+    }
+    const int bin = GetCellIndexOfID(msg_id);
 
     if (inbox_content)
     {
       retriever->SetRetrieved(inbox_content);
-      retriever->AddRetrievedValue(inbox_content);
+      retriever->AddRetrievedValue(inbox_content, msg_id == inbox_content ? bin : GetCellIndexOfID(inbox_content), GetSize());
 
       unsigned int max_known = retriever->GetMaxKnown();
       if (max_known)
@@ -560,14 +1516,15 @@ public:
         retriever->SetMaxKnown(std::max(max_known, retriever_id));
       }
     }
-    auto it = id_to_idx.find(msg_id);
-    if (it != id_to_idx.end())
-    {
-      recv_counts[it->second]++;
-    }
+    if (TileTally *tally = ActiveTally(location))
+      tally->recv_events.push_back(bin);
     else
+      RecordReceive(bin);
+
+    if (tracer)
     {
-      recv_other_count++;
+      tracer->Record(TraceRecord{update, TRACE_RECEIVE, bin >= 0, 0,
+                                 -1, 0, retriever_idx, retriever_id, msg_id});
     }
   }
 };
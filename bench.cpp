@@ -0,0 +1,492 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "World.h"
+#include "ConfigSetup.h"
+MyConfigType worldConfig;
+
+// Microbenchmarks of the simulation's hot paths. Every case prints one row with
+// its time and allocation count per operation, as CSV (default) or JSON lines,
+// so results from different commits can be compared with a diff or a script.
+//
+//   ./bench_project [--format csv|json] [--filter name] [--threads N] [--updates N] [--schedule policy]
+//
+// --check-threads N instead runs the deterministic parallel update with one
+// thread and with N, and exits with 1 if their data rows or genomes differ.
+
+// Every allocation in the process is counted, so allocs_per_op shows hot paths
+// that touch the allocator
+static std::atomic<size_t> num_allocs{0};
+
+void *operator new(size_t size)
+{
+  num_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+// Kept out of line, or GCC warns that free() gets memory from operator new
+__attribute__((noinline)) static void FreeMemory(void *ptr) { std::free(ptr); }
+void operator delete(void *ptr) noexcept { FreeMemory(ptr); }
+void operator delete[](void *ptr) noexcept { FreeMemory(ptr); }
+void operator delete(void *ptr, size_t) noexcept { FreeMemory(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { FreeMemory(ptr); }
+
+struct BenchOptions
+{
+  std::string format = "csv";
+  std::string filter;
+  int threads = 0;
+  int updates = 200;
+  std::string schedule = "legacy";
+  // Compare THREAD_NUM=1 against this many threads instead of timing (0 = off)
+  int check_threads = 0;
+};
+
+/**
+ * The outcome of one benchmark case. org_cycles is left at 0 by cases that
+ * don't run organisms.
+ */
+struct BenchResult
+{
+  std::string name;
+  std::string params;
+  std::string unit;
+  double ops = 0;
+  double seconds = 0;
+  double allocs = 0;
+  double org_cycles = 0;
+};
+
+/**
+ * Times a piece of code and counts the allocations it makes.
+ */
+class BenchTimer
+{
+  std::chrono::steady_clock::time_point start;
+  size_t start_allocs;
+
+public:
+  BenchTimer() : start(std::chrono::steady_clock::now()), start_allocs(num_allocs.load()) { ; }
+
+  void Stop(BenchResult &result) const
+  {
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.allocs = static_cast<double>(num_allocs.load() - start_allocs);
+  }
+};
+
+/**
+ * Input: The result of a case and the output format
+ *
+ * Output: None
+ *
+ * Purpose: Print one row of results.
+ */
+void PrintResult(const BenchResult &r, const std::string &format)
+{
+  const double ns_per_op = r.ops ? r.seconds * 1e9 / r.ops : 0;
+  const double ops_per_sec = r.seconds ? r.ops / r.seconds : 0;
+  const double ns_per_org_cycle = r.org_cycles ? r.seconds * 1e9 / r.org_cycles : 0;
+  const double allocs_per_op = r.ops ? r.allocs / r.ops : 0;
+  if (format == "json")
+  {
+    std::cout << "{\"case\":\"" << r.name << "\",\"params\":\"" << r.params
+              << "\",\"unit\":\"" << r.unit << "\",\"ops\":" << r.ops
+              << ",\"seconds\":" << r.seconds << ",\"ns_per_op\":" << ns_per_op
+              << ",\"ops_per_sec\":" << ops_per_sec << ",\"ns_per_org_cycle\":" << ns_per_org_cycle
+              << ",\"allocs_per_op\":" << allocs_per_op << "}" << std::endl;
+  }
+  else
+  {
+    std::cout << r.name << "," << r.params << "," << r.unit << "," << r.ops << ","
+              << r.seconds << "," << ns_per_op << "," << ops_per_sec << ","
+              << ns_per_org_cycle << "," << allocs_per_op << std::endl;
+  }
+}
+
+/**
+ * Input: A default config, the grid side length, the thread count and the schedule
+ *
+ * Output: None
+ *
+ * Purpose: Every case starts from the default settings with a fixed seed.
+ */
+void SetupConfig(MyConfigType &config, int side, int threads, const std::string &schedule = "legacy")
+{
+  config.SEED(1);
+  config.WORLD_LEN(side);
+  config.WORLD_WIDTH(side);
+  config.THREAD_NUM(threads);
+  config.SCHEDULE(schedule);
+}
+
+/**
+ * Input: A new world and the fraction of its cells to fill
+ *
+ * Output: None
+ *
+ * Purpose: Fill a share of the cells with random organisms.
+ */
+void Populate(OrgWorld &world, double occupancy)
+{
+  sgpl::tlrand.Get().ResetSeed(world.GetConfig().SEED());
+  // InjectOrganism may land on an occupied cell, so draw distinct cells here
+  std::vector<size_t> order(world.GetSize());
+  std::iota(order.begin(), order.end(), 0);
+  emp::Shuffle(world.GetRandom(), order);
+  const size_t count = static_cast<size_t>(occupancy * world.GetSize());
+  for (size_t i = 0; i < count; ++i)
+    world.InjectOrganismAt(order[i]);
+}
+
+// Shortest form of a number, for the params column
+std::string Num(double value)
+{
+  std::ostringstream ss;
+  ss << value;
+  return ss.str();
+}
+
+std::vector<size_t> OccupiedCells(OrgWorld &world)
+{
+  std::vector<size_t> cells;
+  for (size_t i = 0; i < world.GetSize(); ++i)
+  {
+    if (world.IsOccupied(i))
+      cells.push_back(i);
+  }
+  return cells;
+}
+
+// Organism::Process and CPU::RunCPUStep, once per organism per round
+BenchResult BenchProcess(const BenchOptions &options)
+{
+  const int rounds = 50;
+  MyConfigType config;
+  SetupConfig(config, 60, 0);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, 1.0);
+  const std::vector<size_t> cells = OccupiedCells(world);
+  const auto &pop = world.GetPopulation();
+
+  CpuBudget budget;
+  budget.Setup(config);
+
+  BenchResult result{"org_process", "grid=60 occupancy=1", "process"};
+  size_t cycles = 0;
+  BenchTimer timer;
+  for (int round = 0; round < rounds; ++round)
+  {
+    for (size_t i : cells)
+      cycles += pop[i]->Process(emp::WorldPosition(i), budget);
+  }
+  timer.Stop(result);
+  result.ops = static_cast<double>(rounds) * cells.size();
+  result.org_cycles = static_cast<double>(cycles);
+  return result;
+}
+
+// OrgWorld::Update, which includes ProcessAllOrganisms, at one grid size and occupancy
+BenchResult BenchUpdate(const BenchOptions &options, int side, double occupancy)
+{
+  MyConfigType config;
+  SetupConfig(config, side, options.threads, options.schedule);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, occupancy);
+
+  BenchResult result{"update", "grid=" + std::to_string(side) + " occupancy=" + Num(occupancy) +
+                                   " threads=" + std::to_string(options.threads) + " schedule=" + options.schedule,
+                     "update"};
+  const uint64_t cycles_before = world.GetTotalCycles();
+  BenchTimer timer;
+  for (int u = 0; u < options.updates; ++u)
+    world.Update();
+  timer.Stop(result);
+  result.ops = options.updates;
+  result.org_cycles = static_cast<double>(world.GetTotalCycles() - cycles_before);
+  return result;
+}
+
+// SendMessage and RetrieveMessage, with half of the messages being cell IDs
+std::vector<BenchResult> BenchMessages(const BenchOptions &options)
+{
+  const size_t num_ops = 1000000;
+  MyConfigType config;
+  SetupConfig(config, 60, 0);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, 1.0);
+
+  std::vector<int> locations(num_ops);
+  std::vector<unsigned int> messages(num_ops);
+  for (size_t i = 0; i < num_ops; ++i)
+  {
+    locations[i] = static_cast<int>(random.GetUInt(world.GetSize()));
+    messages[i] = random.P(0.5) ? world.GetCellByLinearIndex(random.GetUInt(world.GetSize())).GetID()
+                                : random.GetUInt();
+  }
+
+  BenchResult send{"send_message", "grid=60 occupancy=1 id_fraction=0.5", "message"};
+  {
+    BenchTimer timer;
+    for (size_t i = 0; i < num_ops; ++i)
+      world.SendMessage(locations[i], messages[i]);
+    timer.Stop(send);
+  }
+  send.ops = num_ops;
+
+  BenchResult retrieve{"retrieve_message", "grid=60 occupancy=1 id_fraction=0.5", "message"};
+  {
+    BenchTimer timer;
+    for (size_t i = 0; i < num_ops; ++i)
+      world.RetrieveMessage(locations[i], messages[i]);
+    timer.Stop(retrieve);
+  }
+  retrieve.ops = num_ops;
+  return {send, retrieve};
+}
+
+// ReproduceOrg followed by ReproduceAllValidOrganisms (BirthOffspring). With
+// after_deaths the world starts full and is thinned out to the occupancy, so
+// births into empty cells find idle organisms in the pool
+BenchResult BenchBirth(const BenchOptions &options, double occupancy, bool after_deaths = false)
+{
+  MyConfigType config;
+  SetupConfig(config, 60, 0);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, after_deaths ? 1.0 : occupancy);
+  if (after_deaths)
+  {
+    for (size_t i = 0; i < world.GetSize(); ++i)
+    {
+      if (random.GetDouble() >= occupancy)
+        world.RemoveOrganism(i);
+    }
+  }
+  const std::vector<size_t> cells = OccupiedCells(world);
+  // Births into a sparse world fill it, so those runs are kept short
+  const size_t num_births = (occupancy < 1.0) ? cells.size() / 4 : 100000;
+  const size_t batch = 100;
+
+  std::string params = "grid=60 occupancy=" + Num(occupancy);
+  if (after_deaths)
+    params += " after_deaths=1";
+  BenchResult result{"birth", params, "birth"};
+  BenchTimer timer;
+  for (size_t done = 0; done < num_births; done += batch)
+  {
+    for (size_t i = 0; i < batch; ++i)
+      world.ReproduceOrg(emp::WorldPosition(cells[random.GetUInt(cells.size())]));
+    world.ReproduceAllValidOrganisms();
+  }
+  timer.Stop(result);
+  result.ops = static_cast<double>((num_births + batch - 1) / batch * batch);
+  return result;
+}
+
+// The OnUpdate signal of emp::World, which resets every solve monitor
+BenchResult BenchMonitorReset(const BenchOptions &options)
+{
+  const int updates = 100000;
+  MyConfigType config;
+  SetupConfig(config, 60, 0);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+
+  BenchResult result{"monitor_reset", "tasks=" + std::to_string(world.GetTasks().size()), "update"};
+  BenchTimer timer;
+  for (int u = 0; u < updates; ++u)
+    world.emp::World<Organism>::Update();
+  timer.Stop(result);
+  result.ops = updates;
+  return result;
+}
+
+// OrgWorld::CheckOutput, which scores a state on the compiled task set, and
+// the same tasks called one by one through the virtual Task::CheckOutput
+std::vector<BenchResult> BenchTaskDispatch(const BenchOptions &options)
+{
+  const int rounds = 200;
+  MyConfigType config;
+  SetupConfig(config, 60, 0);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, 1.0);
+  // A few updates give the organisms messages and retrieved values to check
+  for (int u = 0; u < 20; ++u)
+    world.Update();
+  const std::vector<size_t> cells = OccupiedCells(world);
+  const auto &pop = world.GetPopulation();
+
+  const std::string params = "tasks=" + std::to_string(world.GetTasks().size());
+  BenchResult fused{"task_dispatch", params, "check"};
+  {
+    BenchTimer timer;
+    for (int round = 0; round < rounds; ++round)
+    {
+      for (size_t i : cells)
+        world.CheckOutput(pop[i]->GetState());
+    }
+    timer.Stop(fused);
+  }
+  fused.ops = static_cast<double>(rounds) * cells.size();
+
+  BenchResult virtual_calls{"task_dispatch_virtual", params, "check"};
+  {
+    const auto tasks = world.GetTasks();
+    double points = 0;
+    BenchTimer timer;
+    for (int round = 0; round < rounds; ++round)
+    {
+      for (size_t i : cells)
+      {
+        for (Task *task : tasks)
+          points += task->CheckOutput(pop[i]->GetState());
+      }
+    }
+    timer.Stop(virtual_calls);
+    // Keeps the calls from being optimised away
+    if (points == 0.5)
+      std::cerr << points;
+  }
+  virtual_calls.ops = static_cast<double>(rounds) * cells.size();
+  return {fused, virtual_calls};
+}
+
+/**
+ * Input: The number of threads and updates
+ *
+ * Output: What each update's data rows would hold (population, solves per task,
+ * sends and retrieves per bin), then a hash of every organism's genome by cell
+ *
+ * Purpose: Record a deterministic parallel run, for CheckThreads.
+ */
+std::vector<uint64_t> RunFingerprint(int threads, int updates)
+{
+  MyConfigType config;
+  SetupConfig(config, 60, threads);
+  config.DETERMINISTIC(true);
+  emp::Random random(config.SEED());
+  OrgWorld world(random, config);
+  Populate(world, 0.1);
+
+  std::vector<uint64_t> rows;
+  for (int u = 0; u < updates; ++u)
+  {
+    world.Update();
+    rows.push_back(world.GetNumOrgs());
+    for (size_t task = 0; task < world.GetNumTasks(); ++task)
+      rows.push_back(static_cast<uint64_t>(world.GetSolveCount(task)));
+    for (const SparseCounter *counter : {&world.GetSendCounts().GetCurrent(), &world.GetRecvCounts().GetCurrent()})
+    {
+      for (int bin : counter->GetActive())
+        rows.push_back((static_cast<uint64_t>(bin) << 32) | static_cast<uint32_t>(counter->Get(bin)));
+    }
+  }
+  for (size_t i = 0; i < world.GetSize(); ++i)
+  {
+    // FNV-1a over the program's bytes, 0 for empty cells
+    uint64_t hash = 0;
+    if (world.IsOccupied(i))
+    {
+      const auto &program = world.GetOrg(i).GetProgram();
+      const unsigned char *bytes = reinterpret_cast<const unsigned char *>(program.data());
+      hash = 14695981039346656037ull;
+      for (size_t b = 0; b < program.size() * sizeof(program[0]); ++b)
+        hash = (hash ^ bytes[b]) * 1099511628211ull;
+    }
+    rows.push_back(hash);
+  }
+  return rows;
+}
+
+/**
+ * Input: The thread count to compare against one thread, and the number of updates
+ *
+ * Output: Whether both runs gave the same data rows and genomes
+ *
+ * Purpose: Check that DETERMINISTIC parallel updates don't depend on the thread count.
+ */
+bool CheckThreads(int threads, int updates)
+{
+  const std::vector<uint64_t> one = RunFingerprint(1, updates);
+  const std::vector<uint64_t> many = RunFingerprint(threads, updates);
+  const bool same = one == many;
+  std::cout << "threads=1 vs threads=" << threads << " over " << updates << " updates: "
+            << (same ? "same" : "DIFFERENT") << std::endl;
+  return same;
+}
+
+int main(int argc, char *argv[])
+{
+  BenchOptions options;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--format")
+      options.format = argv[i + 1];
+    else if (arg == "--filter")
+      options.filter = argv[i + 1];
+    else if (arg == "--threads")
+      options.threads = std::atoi(argv[i + 1]);
+    else if (arg == "--updates")
+      options.updates = std::atoi(argv[i + 1]);
+    else if (arg == "--schedule")
+      options.schedule = argv[i + 1];
+    else if (arg == "--check-threads")
+      options.check_threads = std::atoi(argv[i + 1]);
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--format csv|json] [--filter name] [--threads N] [--updates N] [--schedule policy] [--check-threads N]" << std::endl;
+      return 1;
+    }
+  }
+  if (options.check_threads > 0)
+    return CheckThreads(options.check_threads, options.updates) ? 0 : 1;
+
+  if (options.format != "json")
+    std::cout << "case,params,unit,ops,seconds,ns_per_op,ops_per_sec,ns_per_org_cycle,allocs_per_op" << std::endl;
+  auto run = [&](const std::string &name, auto bench)
+  {
+    if (options.filter.empty() || name.find(options.filter) != std::string::npos)
+    {
+      for (const BenchResult &result : bench())
+        PrintResult(result, options.format);
+    }
+  };
+  auto one = [](BenchResult result)
+  { return std::vector<BenchResult>{result}; };
+
+  run("org_process", [&]()
+      { return one(BenchProcess(options)); });
+  run("update", [&]()
+      {
+    std::vector<BenchResult> results;
+    for (int side : {30, 60, 120})
+    {
+      for (double occupancy : {0.1, 0.5, 1.0})
+        results.push_back(BenchUpdate(options, side, occupancy));
+    }
+    return results; });
+  run("message", [&]()
+      { return BenchMessages(options); });
+  run("birth", [&]()
+      { return std::vector<BenchResult>{BenchBirth(options, 0.25), BenchBirth(options, 0.25, true), BenchBirth(options, 1.0)}; });
+  run("monitor_reset", [&]()
+      { return one(BenchMonitorReset(options)); });
+  run("task_dispatch", [&]()
+      { return BenchTaskDispatch(options); });
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "IdIndex.h"
+
+// Compares the cost of classifying messages (is this value a cell ID, and at
+// which index?) with the std::unordered_map OrgWorld used to keep against
+// IdIndex, one lookup at a time and in batches. Prints one CSV row per case.
+//
+//   ./bench_id_index [num_cells] [num_lookups]
+
+template <typename FUN>
+double TimeNs(size_t num_lookups, FUN fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / num_lookups;
+}
+
+int main(int argc, char *argv[])
+{
+  const size_t num_cells = (argc > 1) ? std::stoul(argv[1]) : 3600;
+  const size_t num_lookups = (argc > 2) ? std::stoul(argv[2]) : 10000000;
+
+  std::mt19937 rng(1);
+  std::vector<unsigned int> cell_ids(num_cells);
+  for (unsigned int &id : cell_ids)
+    id = rng();
+
+  std::unordered_map<unsigned int, int> id_to_idx;
+  for (size_t idx = 0; idx < num_cells; ++idx)
+    id_to_idx[cell_ids[idx]] = static_cast<int>(idx);
+  IdIndex id_index;
+  id_index.Build(cell_ids);
+
+  std::cout << "hit_rate,unordered_map_ns,find_ns,classify_ns" << std::endl;
+  for (double hit_rate : {0.0, 0.1, 0.5, 0.9, 1.0})
+  {
+    std::bernoulli_distribution is_hit(hit_rate);
+    std::vector<uint32_t> messages(num_lookups);
+    for (uint32_t &message : messages)
+      message = is_hit(rng) ? cell_ids[rng() % num_cells] : rng();
+    std::vector<int> out(num_lookups);
+
+    // The sums keep the lookups from being optimised away
+    long long map_sum = 0, find_sum = 0, classify_sum = 0;
+    double map_ns = TimeNs(num_lookups, [&]()
+                           {
+      for (uint32_t message : messages)
+      {
+        auto it = id_to_idx.find(message);
+        map_sum += (it != id_to_idx.end()) ? it->second : -1;
+      } });
+    double find_ns = TimeNs(num_lookups, [&]()
+                            {
+      for (uint32_t message : messages)
+        find_sum += id_index.Find(message); });
+    double classify_ns = TimeNs(num_lookups, [&]()
+                                {
+      id_index.Classify(messages.data(), out.data(), num_lookups);
+      for (int idx : out)
+        classify_sum += idx; });
+
+    if (map_sum != find_sum || map_sum != classify_sum)
+    {
+      std::cerr << "Lookups disagree at hit rate " << hit_rate << std::endl;
+      return 1;
+    }
+    std::cout << hit_rate << "," << map_ns << "," << find_ns << "," << classify_ns << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,2 @@
+g++ -O3 -DNDEBUG -march=native -Wall -Wno-unused-function -std=c++17 -pthread -Isignalgp-lite/third-party/Empirical/include/ -Isignalgp-lite/include/ bench.cpp -o bench_project
+./bench_project "$@"
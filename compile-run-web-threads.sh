@@ -0,0 +1,11 @@
+emcc -std=c++17 -IEmpirical/include/ -Isignalgp-lite/include/ -Os -pthread -s PTHREAD_POOL_SIZE=1 --js-library Empirical/include/emp/web/library_emp.js -s EXPORTED_FUNCTIONS="['_main', '_empCppCallback', '_empDoCppCallback']" -s "EXTRA_EXPORTED_RUNTIME_METHODS=['ccall', 'cwrap']" -s NO_EXIT_RUNTIME=1 -s TOTAL_MEMORY=268435456 web.cpp -o project_web.js
+# Threads need SharedArrayBuffer, which browsers only allow on cross-origin isolated pages
+python3 -c "
+from http.server import SimpleHTTPRequestHandler, test
+class Handler(SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header('Cross-Origin-Opener-Policy', 'same-origin')
+        self.send_header('Cross-Origin-Embedder-Policy', 'require-corp')
+        super().end_headers()
+test(Handler)
+"
@@ -0,0 +1,2 @@
+g++ -O3 -DNDEBUG -Wall -std=c++17 sparse_to_csv.cpp -o sparse_to_csv
+g++ -O3 -DNDEBUG -Wall -std=c++17 bench_id_index.cpp -o bench_id_index
@@ -1,35 +1,118 @@
-
+#include <algorithm>
 #include <iostream>
 
 #include "World.h"
 #include "ConfigSetup.h"
+#include "Batch.h"
+#include "RunControl.h"
+#include "emp/config/ArgManager.hpp"
 MyConfigType worldConfig;
 
 // This is the main function for the NATIVE version of this project.
 
-int main(int argc, char *argv[])
+/**
+ * Input: The settings of the run and a prefix for its output files
+ *
+ * Output: The exit status of the run
+ *
+ * Purpose: Run one experiment, from scratch or from a checkpoint, up to UPDATE_NUM
+ * or until a stop condition ends it early.
+ */
+int RunExperiment(const MyConfigType &config, const std::string &prefix)
 {
-  std::cout << "Test 0" << std::endl;
-  bool success = worldConfig.Read("MySettings.cfg");
-  if(!success) worldConfig.Write("MySettings.cfg");
-  emp::Random random(worldConfig.SEED());
+  // Batch runs that hadn't started before Ctrl-C don't start at all
+  if (RunController::Interrupted())
+    return 1;
+  emp::Random random(config.SEED());
 
-  OrgWorld world(random);
+  OrgWorld world(random, config);
   // Some SignalGP-Lite functionality uses its own emp::Random instance
   // so it's important to set that seed too when the main Random is created
-  sgpl::tlrand.Get().ResetSeed(worldConfig.SEED());
+  sgpl::tlrand.Get().ResetSeed(config.SEED());
+
+  if (config.RESUME_FILE() != "")
+  {
+    if (!world.LoadCheckpoint(config.RESUME_FILE()))
+    {
+      std::cerr << "Could not resume from " << config.RESUME_FILE() << std::endl;
+      return 1;
+    }
+  }
+  else
+  {
+    for (int i = 0; i < config.START_NUM(); i++)
+    {
+      world.InjectOrganism();
+    }
+  }
 
-  for (int i = 0; i < worldConfig.START_NUM(); i++)
+  if (config.DATA_FORMAT() == "binary")
   {
-    Organism *new_org = new Organism(&world);
-    world.Inject(*new_org);
+    world.SetupSolveSparseFile(prefix + "solveNative.bin").SetTimingRepeat(config.UPDATE_RECORD_FREQUENCY());
+    world.SetupSendRecvSparseFile(prefix + "sendRecvNative.bin").SetTimingRepeat(config.UPDATE_RECORD_FREQUENCY());
   }
+  else
+  {
+    world.SetupSolveFile(prefix + "solveNative.data").SetTimingRepeat(config.UPDATE_RECORD_FREQUENCY());
+    world.SetupSendRecvFile(prefix + "sendRecvNative.data").SetTimingRepeat(config.UPDATE_RECORD_FREQUENCY());
+  }
+  // Point stats aren't integer counts, so they always go to a CSV file
+  world.SetupPopulationFile(prefix + "populationNative.data").SetTimingRepeat(config.UPDATE_RECORD_FREQUENCY());
 
-  world.SetupSolveFile("solveNative.data").SetTimingRepeat(worldConfig.UPDATE_RECORD_FREQUENCY());
-  world.SetupSendRecvFile("sendRecvNative.data").SetTimingRepeat(worldConfig.UPDATE_RECORD_FREQUENCY());
+  RunController control(config, prefix, std::cout);
+  const size_t checkpoint_frequency = std::max(config.CHECKPOINT_FREQUENCY(), 0);
+  while (world.GetUpdate() < (size_t)config.UPDATE_NUM())
+  {
+    // An extinct world can't change any more, so its remaining updates are skipped
+    if (!config.STOP_ON_EXTINCTION() && world.IsFrozen())
+    {
+      std::cout << prefix << "Population extinct at update " << world.GetUpdate() << ", skipping to " << config.UPDATE_NUM() << std::endl;
+      world.FastForward(config.UPDATE_NUM());
+    }
+    else
+      world.Update();
+    if (checkpoint_frequency && world.GetUpdate() % checkpoint_frequency == 0)
+      world.SaveCheckpoint(config.CHECKPOINT_FILE());
+    if (control.ShouldStop(world))
+      break;
+  }
+
+  // Interrupted runs can be resumed from where they stopped
+  if (RunController::Interrupted() && checkpoint_frequency)
+    world.SaveCheckpoint(config.CHECKPOINT_FILE());
+  if (control.GetStopReason().empty())
+    std::cout << prefix << "Finished " << world.GetUpdate() << " updates in " << control.GetElapsedSeconds() << " seconds" << std::endl;
+  else
+    std::cout << prefix << "Stopped at update " << world.GetUpdate() << ": " << control.GetStopReason() << std::endl;
+  // The world's data files are flushed and closed as it goes out of scope
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  bool success = worldConfig.Read("MySettings.cfg");
+  if(!success) worldConfig.Write("MySettings.cfg");
+
+  // Settings on the command line (e.g. -SEED 5) override the file
+  auto specs = emp::ArgManager::make_builtin_specs(&worldConfig);
+  emp::ArgManager am(argc, argv, specs);
+  am.UseCallbacks();
+  if (am.HasUnused())
+  {
+    am.PrintDiagnostic();
+    return 1;
+  }
+  RunController::InstallInterruptHandler();
 
-  for (int update = 0; update < worldConfig.UPDATE_NUM(); update++)
+  if (worldConfig.BATCH_FILE() != "")
   {
-    world.Update();
+    SweepSpec sweep;
+    if (!sweep.Load(worldConfig.BATCH_FILE(), worldConfig))
+    {
+      std::cerr << sweep.GetError() << std::endl;
+      return 1;
+    }
+    return BatchRunner::Run(worldConfig, sweep, std::max(worldConfig.BATCH_THREADS(), 0), RunExperiment, std::cout);
   }
+  return RunExperiment(worldConfig, "");
 }
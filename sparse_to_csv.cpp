@@ -0,0 +1,45 @@
+#include <fstream>
+#include <iostream>
+
+#include "SparseDataFile.h"
+
+// Converts a binary data file written by SparseDataFile back into the CSV
+// layout emp::DataFile uses: a header of keys and one comma-separated row per
+// record, with "update" as the first column.
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <input.bin> [output.csv]" << std::endl;
+    return 1;
+  }
+
+  SparseDataReader reader(argv[1]);
+  if (!reader.IsValid())
+  {
+    std::cerr << "Not a sparse data file: " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::ofstream file_out;
+  if (argc > 2)
+    file_out.open(argv[2]);
+  std::ostream &out = (argc > 2) ? file_out : std::cout;
+
+  out << "update";
+  for (const std::string &name : reader.GetColumns())
+    out << ',' << name;
+  out << '\n';
+
+  size_t update = 0;
+  std::vector<int64_t> values;
+  while (reader.NextRow(update, values))
+  {
+    out << update;
+    for (int64_t value : values)
+      out << ',' << value;
+    out << '\n';
+  }
+  return 0;
+}
@@ -2,6 +2,7 @@
 #define UIT_SUPPRESS_MACRO_INSEEP_WARNINGS
 
 #include <deque>
+#include <emscripten.h>
 #include "emp/math/Random.hpp"
 #include "emp/math/math.hpp"
 #include "emp/web/Animate.hpp"
@@ -11,6 +12,8 @@
 #include "Org.h"
 #include "Cell.h"
 #include "ConfigSetup.h"
+#include "PixelGrid.h"
+#include "SimThread.h"
 #include "emp/config/ArgManager.hpp"
 #include "emp/prefab/ConfigPanel.hpp"
 #include "emp/web/UrlParams.hpp"
@@ -31,6 +34,37 @@ struct Stats
     double variance;
 };
 
+/**
+ * What the page shows of the world after a batch of updates. It is built on
+ * the simulation side, so drawing a frame never touches the world.
+ */
+struct FrameSnapshot
+{
+    // Pixel color and facing of every cell (x * height + y); -1 faces nowhere
+    std::vector<uint32_t> colors;
+    std::vector<int8_t> facings;
+    Stats stats{};
+    // Solves of each task in the last update
+    std::vector<int> solves;
+    // Cells that messages were sent to or retrieved from in the last update
+    struct CellTraffic
+    {
+        unsigned int id;
+        int sent;
+        int received;
+    };
+    std::vector<CellTraffic> traffic;
+    int other_sent = 0;
+    int other_received = 0;
+};
+
+// Web builds made with -pthread run the world on its own thread
+#ifdef __EMSCRIPTEN_PTHREADS__
+constexpr bool SIM_THREADED = true;
+#else
+constexpr bool SIM_THREADED = false;
+#endif
+
 class AEAnimator : public emp::web::Animate
 {
     const int num_h_boxes = worldConfig.WORLD_LEN();
@@ -38,16 +72,30 @@ class AEAnimator : public emp::web::Animate
     const double RECT_SIDE = worldConfig.CELL_SIZE();
     const double width{num_w_boxes * RECT_SIDE};
     const double height{num_h_boxes * RECT_SIDE};
-    static constexpr double dir_dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
-    static constexpr double dir_dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
-    unsigned int max_known_id;
-    unsigned int min_known_id;
+    unsigned int max_known_id = 0;
+    unsigned int min_known_id = 0;
     long long cycle = 0;
+    int updates_per_frame = std::max(worldConfig.UPDATES_PER_FRAME(), 1);
 
     emp::Random random{worldConfig.SEED()};
-    OrgWorld world{random};
+    OrgWorld world{random, worldConfig};
 
     emp::web::Canvas canvas{width, height, "canvas"};
+    // The frame is drawn here and copied to the canvas in one go
+    PixelGrid pixels{(size_t)num_w_boxes, (size_t)num_h_boxes, (size_t)RECT_SIDE};
+    std::vector<uint32_t> task_colors;
+    std::vector<std::string> task_swatches;
+    std::vector<std::string> task_names;
+
+    // The world (and its render view) is only touched by the simulation side
+    // of this after setup
+    RenderView view;
+    FrameSnapshot frame;
+    SimThread<FrameSnapshot> sim{[this]()
+                                 { world.Update(); },
+                                 [this](FrameSnapshot &snapshot)
+                                 { BuildSnapshot(snapshot); },
+                                 SIM_THREADED};
 
 public:
     // Constructor
@@ -56,6 +104,13 @@ public:
         SetupCanvas();
         SetupConfigPanel();
         SetupWorld();
+        auto tasks = world.GetTasks();
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            task_colors.push_back(PixelGrid::HSV(TaskHue(i), 1.0, 1.0));
+            task_swatches.push_back(emp::ColorHSV(TaskHue(i), 1.0, 1.0));
+            task_names.push_back(tasks[i]->name());
+        }
     }
 
     /**
@@ -70,6 +125,12 @@ public:
         doc << canvas;
         doc << GetToggleButton("Toggle");
         doc << GetStepButton("Step");
+        doc << emp::web::Input([this](std::string value)
+                               { updates_per_frame = std::max(std::atoi(value.c_str()), 1); },
+                               "number", "Updates per frame", "updates_per_frame")
+                   .Min(1)
+                   .Max(10000)
+                   .Value(updates_per_frame);
     }
 
     /**
@@ -89,6 +150,26 @@ public:
                  "WORLD_LEN",
                  "WORLD_WIDTH",
                  "CELL_SIZE",
+                 "THREAD_NUM",
+                 "TILE_SIZE",
+                 "DETERMINISTIC",
+                 "DATA_FORMAT",
+                 "BATCH_FILE",
+                 "BATCH_THREADS",
+                 "CHECKPOINT_FILE",
+                 "CHECKPOINT_FREQUENCY",
+                 "RESUME_FILE",
+                 "TRACE_FILE",
+                 "TRACE_BUFFER",
+                 "PROFILE_FILE",
+                 "PROGRESS_INTERVAL",
+                 "STOP_ON_EXTINCTION",
+                 "QUIESCENT_WINDOW",
+                 "STOP_SOLVE_RATE",
+                 "STOP_SOLVE_TASK",
+                 "MAX_WALL_SECONDS",
+                 "PROFILE_FREQUENCY",
+                 "UPDATES_PER_FRAME",
              })
         {
             config_panel.ExcludeSetting(name);
@@ -117,8 +198,7 @@ public:
     {
         for (int i = 0; i < worldConfig.START_NUM(); i++)
         {
-            Organism *new_org = new Organism(&world);
-            world.Inject(*new_org);
+            world.InjectOrganism();
         }
     }
 
@@ -131,37 +211,18 @@ public:
      *
      * Output: Number of organisms in the world, the min and max points among them, plus their mean and variance of points
      *
-     * Purpose: Compute the stats to assist in displaying the organisms.
+     * Purpose: Read the stats to assist in displaying the organisms. The world
+     * keeps them up to date, so this doesn't scan the population.
      */
     Stats ComputeStats()
     {
+        const PopulationStats &pop_stats = world.GetPopulationStats();
         Stats s;
-        s.max = 0.0;
-        s.min = std::numeric_limits<double>::infinity();
-        double sum = 0.0, sum_sq = 0.0;
-        s.count = 0;
-
-        for (int i = 0; i < world.GetSize(); ++i)
-        {
-            if (!world.IsOccupied(i))
-                continue;
-            double p = world.GetOrg(i).GetPoints();
-            s.max = std::max(s.max, p);
-            s.min = std::min(s.min, p);
-            sum += p;
-            sum_sq += p * p;
-            ++s.count;
-        }
-        if (s.count == 0)
-        {
-            s.min = 0.0;
-            s.max = 0.0;
-        }
-        s.mean = s.count ? (sum / s.count) : 0.0;
-        s.variance = s.count
-                         ? (sum_sq / s.count) - (s.mean * s.mean)
-                         : 0.0;
-
+        s.count = static_cast<int>(pop_stats.GetCount());
+        s.min = pop_stats.GetMinPoints();
+        s.max = pop_stats.GetMaxPoints();
+        s.mean = pop_stats.GetMean();
+        s.variance = pop_stats.GetVariance();
         return s;
     }
 
@@ -184,27 +245,23 @@ public:
     }
 
     /**
-     * Input: None
+     * Input: The latest snapshot
      *
      * Output: None
      *
      * Purpose: Render a legend of task‐colors and the per‐tick solves
      */
-    void RecordTaskPanel()
+    void RecordTaskPanel(const FrameSnapshot &snapshot)
     {
         tasksDoc.Clear();
         tasksDoc << "<div id='tasks-content'>";
-        auto tasks = world.GetTasks();
-        auto mons = world.GetSolveMonitors();
 
-        for (size_t i = 0; i < tasks.size(); ++i)
+        for (size_t i = 0; i < task_names.size(); ++i)
         {
-            std::string swatch_color = emp::ColorHSV(TaskHue(i), 1.0, 1.0);
-            int solves = mons[i]->GetTotal();
             tasksDoc << "<div class='task-entry'>"
-                     << "<span class='task-swatch' style='background:" << swatch_color << "'></span>"
-                     << tasks[i]->name()
-                     << " — Solves: " << solves
+                     << "<span class='task-swatch' style='background:" << task_swatches[i] << "'></span>"
+                     << task_names[i]
+                     << " — Solves: " << snapshot.solves[i]
                      << "</div>";
         }
 
@@ -212,46 +269,30 @@ public:
     }
 
     /**
-     * Input: None
+     * Input: The latest snapshot
      *
      * Output: None
      *
      * Purpose: Render a list of cell-IDs being sent at any moment
      */
-    void RecordCellPanel()
+    void RecordCellPanel(const FrameSnapshot &snapshot)
     {
         cellsDoc.Clear();
         cellsDoc << "<h4>Cell ID Sent / Received</h4>";
 
-        auto sendMons = world.GetSendMonitors();
-        auto recvMons = world.GetRecvMonitors();
-        auto sendOtherMon = world.GetSendOtherMon(); 
-        auto recvOtherMon = world.GetRecvOtherMon();
-        const int total = num_w_boxes * num_h_boxes;
-
-        for (int i = 0; i < total; i++)
+        for (const FrameSnapshot::CellTraffic &cell : snapshot.traffic)
         {
-            int sends = sendMons[i]->GetTotal();
-            int recvs = recvMons[i]->GetTotal();
-
-            if (sends == 0 && recvs == 0) 
-            continue;
-
-            unsigned int cell_id = world.GetCellByLinearIndex(i)->GetID();
             cellsDoc << "<div class='cell-entry'>"
-                    << "Cell " << cell_id
-                    << " — Sent: " << sends
-                    << ", Received: " << recvs
+                    << "Cell " << cell.id
+                    << " — Sent: " << cell.sent
+                    << ", Received: " << cell.received
                     << "</div>";
-           
         }
-        int oSends = sendOtherMon->GetTotal();
-        int oRecvs = recvOtherMon->GetTotal();
-        if (oSends != 0 || oRecvs != 0) {
+        if (snapshot.other_sent != 0 || snapshot.other_received != 0) {
                 cellsDoc << "<div class='non-cell-entry'>"
                         << "Non ID " << " value"
-                        << " — Sent: " << oSends
-                        << ", Received: " << oRecvs
+                        << " — Sent: " << snapshot.other_sent
+                        << ", Received: " << snapshot.other_received
                         << "</div>";
             }
     }
@@ -314,30 +355,47 @@ public:
     }
 
     /**
-     * Input: An organism
+     * Input: The world's render view and an occupied cell
      *
-     * Output: A string describing the color the organism should be
+     * Output: The pixel color the organism should be
      *
      * Purpose: Calculate the color of the organism based on its best task done.
      */
-    std::string OrgColor(Organism &org)
+    uint32_t OrgColor(const RenderView &view, size_t i)
     {
-        Cell *cur_cell = org.GetCell();
-        unsigned int cur_id = cur_cell->GetID();
-        unsigned int cur_message = org.GetMessage();
-        size_t best = org.GetBestTask();
+        unsigned int cur_id = view.cell_ids[i];
+        unsigned int cur_message = view.message[i];
+        size_t best = view.best_task[i];
 
-        double brightness = OrgBrightness(cur_id);
-        std::string fill;
         if ((cur_message && cur_message == max_known_id) || cur_id == max_known_id)
         {
-            fill = emp::ColorHSV(0, 1.0, brightness);
-        }
-        else
-        {
-            fill = emp::ColorHSV(TaskHue(best), 1.0, 1.0);
+            return PixelGrid::HSV(0, 1.0, OrgBrightness(cur_id));
         }
-        return fill;
+        return task_colors[std::min(best, task_colors.size() - 1)];
+    }
+
+    /**
+     * Input: None
+     *
+     * Output: None
+     *
+     * Purpose: Copy the part of the frame that changed onto the canvas with a
+     * single putImageData. Only the changed rows are copied out of the
+     * WebAssembly heap (ImageData can't be built on a view of it), and only the
+     * changed columns of those are painted.
+     */
+    void BlitPixels()
+    {
+        if (!pixels.IsDirty())
+            return;
+        EM_ASM({
+            var ctx = document.getElementById(UTF8ToString($0)).getContext('2d');
+            var bytes = HEAPU8.slice($1, $1 + $2 * $3 * 4);
+            ctx.putImageData(new ImageData(new Uint8ClampedArray(bytes.buffer), $2, $3), 0, $4, $5, 0, $6, $3);
+        }, canvas.GetID().c_str(), pixels.GetPixels() + pixels.GetDirtyTop() * pixels.GetWidth(),
+           pixels.GetWidth(), pixels.GetDirtyHeight(), pixels.GetDirtyTop(),
+           pixels.GetDirtyLeft(), pixels.GetDirtyWidth());
+        pixels.ClearDirty();
     }
 
     /**
@@ -346,58 +404,49 @@ public:
      * Output: None
      *
      * Purpose: Load the global varibles keeping track of max and min known IDs, for when the full board is not filled.
+     * The world tracks the range of occupied IDs, so only its ends are folded in.
      */
     void GetKnownIDRange()
     {
-        int org_num = 0;
-        for (int x = 0; x < num_w_boxes; x++)
+        const PopulationStats &pop_stats = world.GetPopulationStats();
+        if (pop_stats.GetCount())
         {
-            for (int y = 0; y < num_h_boxes; y++)
+            unsigned int new_id = pop_stats.GetMaxID();
+            if (max_known_id)
             {
-                if (world.IsOccupied(org_num))
-                {
-                    unsigned int new_id = world.GetCellByGridCoord(x, y)->GetID();
-                    if (max_known_id)
-                    {
-                        max_known_id = std::max(max_known_id, new_id);
-                    }
-                    else
-                    {
-                        max_known_id = new_id;
-                    }
-
-                    if (min_known_id)
-                    {
-                        min_known_id = std::min(min_known_id, new_id);
-                    }
-                    else
-                    {
-                        min_known_id = new_id;
-                    }
-                }
-                org_num++;
+                max_known_id = std::max(max_known_id, new_id);
+            }
+            else
+            {
+                max_known_id = new_id;
+            }
+
+            new_id = pop_stats.GetMinID();
+            if (min_known_id)
+            {
+                min_known_id = std::min(min_known_id, new_id);
+            }
+            else
+            {
+                min_known_id = new_id;
             }
         }
     }
 
     /**
-     * Input: None
+     * Input: The snapshot to fill in
      *
      * Output: None
      *
-     * Purpose: Update the frame showing the world and draw it again.and_eq
+     * Purpose: Record what the page shows of the world. Runs on the simulation
+     * side, after each batch of updates.
      */
-    void DoFrame() override
+    void BuildSnapshot(FrameSnapshot &snapshot)
     {
-        canvas.Clear();
-        world.Update();
-
-        Stats st = ComputeStats();
-        StatsRecord(st);
-        RecordTaskPanel();
-        RecordCellPanel();
+        world.FillRenderView(view);
+        snapshot.stats = ComputeStats();
 
-        if (st.count < num_h_boxes * num_w_boxes)
+        if (view.live.size() < view.num_cells)
         {
             GetKnownIDRange();
         }
@@ -407,53 +456,88 @@ public:
             min_known_id = world.GetMinID();
         }
 
+        snapshot.colors.assign(view.num_cells, PixelGrid::WHITE);
+        snapshot.facings.assign(view.num_cells, -1);
+        for (uint32_t i : view.live)
+        {
+            snapshot.colors[i] = OrgColor(view, i);
+            snapshot.facings[i] = static_cast<int8_t>(view.facings[i]);
+        }
+
+        snapshot.solves.resize(world.GetNumTasks());
+        for (size_t i = 0; i < snapshot.solves.size(); ++i)
+            snapshot.solves[i] = world.GetSolveTotal(i);
+
+        // Only bins that saw traffic last update; sent-to bins first, then
+        // bins that were only retrieved from
+        const SparseCounter &sends = world.GetSendCounts().GetLast();
+        const SparseCounter &recvs = world.GetRecvCounts().GetLast();
+        snapshot.traffic.clear();
+        for (int bin : sends.GetActive())
+        {
+            if (bin != 0)
+                snapshot.traffic.push_back({world.GetCellByLinearIndex(bin - 1).GetID(), sends.Get(bin), recvs.Get(bin)});
+        }
+        for (int bin : recvs.GetActive())
+        {
+            if (bin != 0 && sends.Get(bin) == 0)
+                snapshot.traffic.push_back({world.GetCellByLinearIndex(bin - 1).GetID(), 0, recvs.Get(bin)});
+        }
+        snapshot.other_sent = sends.Get(0);
+        snapshot.other_received = recvs.Get(0);
+    }
+
+    /**
+     * Input: The latest snapshot
+     *
+     * Output: None
+     *
+     * Purpose: Draw a snapshot onto the canvas and the panels.
+     */
+    void DrawSnapshot(const FrameSnapshot &snapshot)
+    {
+        // The panels rebuild their HTML, so while running they only refresh
+        // every PANEL_FREQUENCY frames
+        if (!GetActive() || cycle % std::max(worldConfig.PANEL_FREQUENCY(), 1) == 0)
+        {
+            StatsRecord(snapshot.stats);
+            RecordTaskPanel(snapshot);
+            RecordCellPanel(snapshot);
+        }
+
         int org_num = 0;
         for (int x = 0; x < num_w_boxes; x++)
         {
             for (int y = 0; y < num_h_boxes; y++)
             {
-                if (!world.IsOccupied(org_num))
-                {
-                    canvas.Rect(x * RECT_SIDE, y * RECT_SIDE, RECT_SIDE, RECT_SIDE,
-                                "white", "black");
-                }
-                else
-                {
-                    Organism org = world.GetOrg(org_num);
-                    Cell *cur_cell = world.GetCellByGridCoord(x, y);
-
-                    std::string cell_color = OrgColor(org);
-
-                    std::string isMax = "";
-                    if (cur_cell->GetID() == max_known_id)
-                    {
-                        isMax = " MAX ";
-                    }
-
-                    std::string arrow_color = "black";
-                    canvas.Rect(x * RECT_SIDE, y * RECT_SIDE, RECT_SIDE, RECT_SIDE,
-                                cell_color, "black");
-
-                    Cell *C = world.GetCellByLinearIndex(org_num);
-                    int dir = C->GetFacing();
-                    double cx = x * RECT_SIDE + (RECT_SIDE / 2.0);
-                    double cy = y * RECT_SIDE + (RECT_SIDE / 2.0);
-
-                    double step = 0.4 * RECT_SIDE;
-                    double ex = cx + dir_dx[dir] * step;
-                    double ey = cy + dir_dy[dir] * step;
-
-                    canvas.Line(cx, cy, ex, ey, arrow_color, 2);
-                }
-
+                // Only cells that look different from last frame are drawn
+                pixels.DrawCell(x, y, snapshot.colors[org_num], snapshot.facings[org_num]);
                 org_num++;
             }
         }
-    
+        BlitPixels();
+    }
+
+    /**
+     * Input: None
+     *
+     * Output: None
+     *
+     * Purpose: Ask for the next updates_per_frame updates and draw the latest
+     * snapshot. While running, a frame shows whichever batch has finished, so
+     * a slow batch never holds up the page; a single Step waits for its batch.
+     */
+    void DoFrame() override
+    {
+        sim.Request(updates_per_frame);
+        if (!sim.TakeSnapshot(frame, !GetActive()))
+            return;
+        DrawSnapshot(frame);
+
         std::cout << "Cycle: " << cycle << std::endl;
         cycle = cycle + 1;
     }
 };
 
 AEAnimator animator;
-int main() { animator.Step(); }
\ No newline at end of file
+int main() { animator.Step(); }